@@ -6,578 +6,414 @@
 
 #include "Dungeon/dijkstra.h"
 #include "Dungeon/dungeon.h"
+#include "Dungeon/fov.h"
 #include "Helpers/helpers.h"
+#include "Helpers/random.h"
 #include "Settings/character-settings.h"
 #include "Settings/exit-codes.h"
 #include "Settings/print-settings.h"
 
+// Lookup tables for how each type of monster is printed, indexed by behavior. See print-settings.h
+static const char monster_chars[NUM_MONSTER_TYPES] = {
+        MONSTER_0_CHAR, MONSTER_1_CHAR, MONSTER_2_CHAR, MONSTER_3_CHAR, MONSTER_4_CHAR, MONSTER_5_CHAR,
+        MONSTER_6_CHAR, MONSTER_7_CHAR, MONSTER_8_CHAR, MONSTER_9_CHAR, MONSTER_10_CHAR, MONSTER_11_CHAR,
+        MONSTER_12_CHAR, MONSTER_13_CHAR, MONSTER_14_CHAR, MONSTER_15_CHAR
+};
+static const Color_T monster_colors[NUM_MONSTER_TYPES] = {
+        MONSTER_0_COLOR, MONSTER_1_COLOR, MONSTER_2_COLOR, MONSTER_3_COLOR, MONSTER_4_COLOR, MONSTER_5_COLOR,
+        MONSTER_6_COLOR, MONSTER_7_COLOR, MONSTER_8_COLOR, MONSTER_9_COLOR, MONSTER_10_COLOR, MONSTER_11_COLOR,
+        MONSTER_12_COLOR, MONSTER_13_COLOR, MONSTER_14_COLOR, MONSTER_15_COLOR
+};
+
 // Enum for possible neighbor directions. Not necessary, but helps avoid programming errors.
 typedef enum Direction_E {
     NORTH, SOUTH, WEST, EAST, NORTHWEST, NORTHEAST, SOUTHWEST, SOUTHEAST, STUCK
 } Direction_T;
 
-// Helper to determine if a monster can see the player
-static bool can_see_player(Character_T *c) {
-    Dungeon_T *d;
-    int delta_y, delta_x, dir_x, dir_y, error, i, j, r;
-
-    // Set up our variables
-    d = c->d;
-
-    delta_y = abs(c->y - d->player->y);
-    delta_x = abs(c->x - d->player->x);
-
-    dir_y = d->player->y > c->y ? 1 : -1;
-    dir_x = d->player->x > c->x ? 1 : -1;
-    error = delta_y - delta_x;
-
-    i = c->y;
-    j = c->x;
-
-    r = 1 + delta_y + delta_x;
-    delta_y *= 2;
-    delta_x *= 2;
-
-    // Travel towards the player
-    while (r > 0) {
-        if (d->MAP(i, j).type == ROCK) {
-            return false;
-        }
-
-        // Error keeps track of which cells we are moving through.
-        if (error > 0) {
-            i += dir_y;
-            error -= delta_y;
-        } else {
-            j += dir_x;
-            error += delta_x;
-        }
-
-        r++;
-    }
-
-    return true;
+// Helper to determine if a monster can see the player. Sight goes both ways, so it's just a check if the player can see
+// the monster's cell, which the dungeon keeps up to date in a bitset (see build_dungeon_fov()).
+static bool can_see_player(Dungeon_T *d, Character_ID_T id) {
+    return VISIBLE(d->monsters.y[id], d->monsters.x[id]);
 }
 
-// Helper that determines a random move for a monster
-static Direction_T calculate_random_move(Character_T *c) {
-    Dungeon_T *d;
-    Direction_T directions[8];
-    int possible_count;
-
-    // Define our dungeon as a variable so we can use macros
-    d = c->d;
-
-    possible_count = 0;
-
-    // Start figuring out what directions we can go
-    if (c->y - 1 > 0 && (c->behavior & TUNNELER || d->MAP(c->y - 1, c->x).type != ROCK)) {
-        possible_count++;
-        directions[possible_count - 1] = NORTH;
-    }
-
-    // Check south
-    if (c->y + 1 < d->height && (c->behavior & TUNNELER || d->MAP(c->y + 1, c->x).type != ROCK)) {
-        possible_count++;
-        directions[possible_count - 1] = SOUTH;
-    }
-
-    // Check west
-    if (c->x - 1 > 0 && (c->behavior & TUNNELER || d->MAP(c->y, c->x - 1).type != ROCK)) {
-        possible_count++;
-        directions[possible_count - 1] = WEST;
-    }
-
-    // Check east
-    if (c->x + 1 < d->width && (c->behavior & TUNNELER || d->MAP(c->y, c->x + 1).type != ROCK)) {
-        possible_count++;
-        directions[possible_count - 1] = EAST;
-    }
-
-    // Only emit diagonal code if characters can travel diagonally
-    #if CHARACTER_DIAGONAL_TRAVEL == true
-
-    // Check northwest
-    if (c->y - 1 > 0 && c->x - 1 > 0 && (c->behavior & TUNNELER || d->MAP(c->y - 1, c->x - 1).type != ROCK)) {
-        possible_count++;
-        directions[possible_count - 1] = NORTHWEST;
-    }
-
-    // Check northeast
-    if (c->y - 1 > 0 && c->x + 1 < d->width && (c->behavior & TUNNELER || d->MAP(c->y - 1, c->x + 1).type != ROCK)) {
-        possible_count++;
-        directions[possible_count - 1] = NORTHEAST;
-    }
-
-    // Check southwest
-    if (c->y + 1 < d->height && c->x - 1 > 0 && (c->behavior & TUNNELER || d->MAP(c->y + 1, c->x - 1).type != ROCK)) {
-        possible_count++;
-        directions[possible_count - 1] = SOUTHWEST;
-    }
-
-    // Check southwest. Don't need to save cost because it's just used as a transient.
-    if (c->y + 1 < d->height && c->x + 1 < d->width &&
-        (c->behavior & TUNNELER || d->MAP(c->y + 1, c->x + 1).type != ROCK)) {
-        possible_count++;
-        directions[possible_count - 1] = SOUTHEAST;
-    }
-    #endif
-
-    // If no direction was found, the monster is stuck
-    if (possible_count == 0) {
-        return STUCK;
-    }
-
-    // Pick a random direction of the ones we have figured out we can move to
-    return directions[rand_int_in_range(0, possible_count - 1)];
+// Offsets to each neighbor of a cell as (y, x), in the same order as Direction_T. Only the first four are used if
+// characters can't travel diagonally.
+static const int neighbors[8][2] = {
+        {-1, 0},
+        {1,  0},
+        {0,  -1},
+        {0,  1},
+        {-1, -1},
+        {-1, 1},
+        {1,  -1},
+        {1,  1}
+};
+#define NUM_NEIGHBORS (CHARACTER_DIAGONAL_TRAVEL ? 8 : 4)
+
+// Macros for the checks every move makes on a neighbor: that it's inside of the outer wall, and that the monster can
+// actually step there. Tunnels is always a constant in the templates below, so the compiler drops the check for rock
+// entirely in the tunneling versions.
+#define IN_DUNGEON(a, b) ((a) > 0 && (a) < d->height && (b) > 0 && (b) < d->width)
+#define CAN_ENTER(tunnels, a, b) ((tunnels) || d->TYPE(a, b) != ROCK)
+
+// Template for a helper that determines a random move for a monster. One copy is made for monsters that tunnel and one
+// for monsters that don't.
+#define RANDOM_MOVE_TEMPLATE(name, tunnels) \
+static Direction_T name(Dungeon_T *d, int y, int x) { \
+    Direction_T directions[8]; \
+    int i, possible_count; \
+\
+    /* Figure out what directions we can go */ \
+    possible_count = 0; \
+    for (i = 0; i < NUM_NEIGHBORS; i++) { \
+        if (IN_DUNGEON(y + neighbors[i][0], x + neighbors[i][1]) && \
+            CAN_ENTER(tunnels, y + neighbors[i][0], x + neighbors[i][1])) { \
+            directions[possible_count] = (Direction_T) i; \
+            possible_count++; \
+        } \
+    } \
+\
+    /* Pick a random direction of the ones we can move to, or be stuck if there aren't any */ \
+    return possible_count == 0 ? STUCK : directions[random_bounded(&d->random, (uint32_t) possible_count)]; \
 }
 
-static Direction_T calculate_intelligent_monster_move(Character_T *c) {
-    Dungeon_T *d;
-    int *cost;
-    Direction_T direction;
-    int best_cost;
-
-    // Define our dungeon and cost map as a variable so we can use macros.
-    d = c->d;
-    cost = c->cost;
-
-    // Move randomly if they are erratic
-    if (c->behavior & ERRATIC && rand() % 2) { // NOLINT(cert-msc50-cpp)
-        return calculate_random_move(c);
-    }
-
-    // Initialize our variables for finding the best node
-    direction = STUCK;
-    best_cost = INT_MAX;
-
-    // Start with north
-    if (c->y - 1 > 0 && COST(c->y - 1, c->x) < best_cost) {
-        direction = NORTH;
-        best_cost = COST(c->y - 1, c->x);
-    }
-
-    // Check south
-    if (c->y + 1 < d->height && COST(c->y + 1, c->x) < best_cost) {
-        direction = SOUTH;
-        best_cost = COST(c->y + 1, c->x);
-    }
-
-    // Check west
-    if (c->x - 1 > 0 && COST(c->y, c->x - 1) < best_cost) {
-        direction = WEST;
-        best_cost = COST(c->y, c->x - 1);
-    }
-
-    // Check east
-    if (c->x + 1 < d->width && COST(c->y, c->x + 1) < best_cost) {
-        direction = EAST;
-        best_cost = COST(c->y, c->x + 1);
-    }
-
-    // Only emit diagonal code if characters can travel diagonally
-    #if CHARACTER_DIAGONAL_TRAVEL == true
-
-    // Check northwest
-    if (c->y - 1 > 0 && c->x - 1 > 0 && COST(c->y - 1, c->x - 1) < best_cost) {
-        direction = NORTHWEST;
-        best_cost = COST(c->y - 1, c->x - 1);
-    }
-
-    // Check northeast
-    if (c->y - 1 > 0 && c->x + 1 < d->width && COST(c->y - 1, c->x + 1) < best_cost) {
-        direction = NORTHEAST;
-        best_cost = COST(c->y - 1, c->x + 1);
-    }
-
-    // Check southwest
-    if (c->y + 1 < d->height && c->x - 1 > 0 && COST(c->y + 1, c->x - 1) < best_cost) {
-        direction = SOUTHWEST;
-        best_cost = COST(c->y + 1, c->x - 1);
-    }
-
-    // Check southwest. Don't need to save cost because it's just used as a transient.
-    if (c->y + 1 < d->height && c->x + 1 < d->width && COST(c->y + 1, c->x + 1) < best_cost) {
-        direction = SOUTHEAST;
-    }
-    #endif
-
-    // Start checking the other directions
-    return direction;
+// Template for a helper that determines a move straight towards the player, for monsters that aren't smart enough to
+// path find. One copy is made for monsters that tunnel and one for monsters that don't.
+#define STRAIGHT_MOVE_TEMPLATE(name, tunnels) \
+static Direction_T name(const Dungeon_T *d, int y, int x) { \
+    Direction_T direction; \
+    int i, best_cost; \
+\
+    /* Pick whichever neighbor we can step on gets us closest */ \
+    direction = STUCK; \
+    best_cost = INT_MAX; \
+    for (i = 0; i < NUM_NEIGHBORS; i++) { \
+        if (IN_DUNGEON(y + neighbors[i][0], x + neighbors[i][1]) && \
+            CAN_ENTER(tunnels, y + neighbors[i][0], x + neighbors[i][1])) { \
+            int cost = manhattan_distance(y + neighbors[i][0], x + neighbors[i][1], d->player->y, d->player->x); \
+            if (cost < best_cost) { \
+                direction = (Direction_T) i; \
+                best_cost = cost; \
+            } \
+        } \
+    } \
+\
+    return direction; \
 }
 
-static Direction_T calculate_unintelligent_monster_move(Character_T *c) {
-    Dungeon_T *d;
-    Direction_T direction;
-    int best_cost;
-
-    // Define our dungeon as a variable so we can use macros
-    d = c->d;
+RANDOM_MOVE_TEMPLATE(calculate_random_walk, false)
+RANDOM_MOVE_TEMPLATE(calculate_random_tunnel, true)
+STRAIGHT_MOVE_TEMPLATE(calculate_straight_walk, false)
+STRAIGHT_MOVE_TEMPLATE(calculate_straight_tunnel, true)
 
-    // Move randomly if they are erratic
-    if (c->behavior & ERRATIC && rand() % 2) { // NOLINT(cert-msc50-cpp)
-        return calculate_random_move(c);
-    }
+// Helper that determines a move for a monster that follows a cost map, by rolling downhill
+static Direction_T calculate_intelligent_monster_move(const Dungeon_T *d, int y, int x, const int *cost) {
+    Direction_T direction;
+    int i, best_cost;
 
-    // Initialize our variables for finding the best node
+    // Pick whichever neighbor is cheapest. Cells that can't be entered cost INT_MAX, so they're never picked.
     direction = STUCK;
     best_cost = INT_MAX;
-
-    // Start with north
-    if (c->y - 1 > 0 && (c->behavior & TUNNELER || d->MAP(c->y - 1, c->x).type != ROCK)) {
-        direction = NORTH;
-        best_cost = manhattan_distance(c->y - 1, c->x, d->player->y, d->player->x);
-    }
-
-    // Check south
-    if (c->y + 1 < d->height && (c->behavior & TUNNELER || d->MAP(c->y + 1, c->x).type != ROCK)) {
-        int cost = manhattan_distance(c->y + 1, c->x, d->player->y, d->player->x);
-        if (cost < best_cost) {
-            direction = SOUTH;
-            best_cost = cost;
-        }
-    }
-
-    // Check west
-    if (c->x - 1 > 0 && (c->behavior & TUNNELER || d->MAP(c->y, c->x - 1).type != ROCK)) {
-        int cost = manhattan_distance(c->y, c->x - 1, d->player->y, d->player->x);
-        if (cost < best_cost) {
-            direction = WEST;
-            best_cost = cost;
-        }
-    }
-
-    // Check east
-    if (c->x + 1 < d->width && (c->behavior & TUNNELER || d->MAP(c->y, c->x + 1).type != ROCK)) {
-        int cost = manhattan_distance(c->y, c->x + 1, d->player->y, d->player->x);
-        if (cost < best_cost) {
-            direction = EAST;
-            best_cost = cost;
+    for (i = 0; i < NUM_NEIGHBORS; i++) {
+        if (IN_DUNGEON(y + neighbors[i][0], x + neighbors[i][1]) &&
+            COST(y + neighbors[i][0], x + neighbors[i][1]) < best_cost) {
+            direction = (Direction_T) i;
+            best_cost = COST(y + neighbors[i][0], x + neighbors[i][1]);
         }
     }
 
-    // Only emit diagonal code if characters can travel diagonally
-    #if CHARACTER_DIAGONAL_TRAVEL == true
-
-    // Check northwest
-    if (c->y - 1 > 0 && c->x - 1 > 0 && (c->behavior & TUNNELER || d->MAP(c->y - 1, c->x - 1).type != ROCK)) {
-        int cost = manhattan_distance(c->y - 1, c->x - 1, d->player->y, d->player->x);
-        if (cost < best_cost) {
-            direction = NORTHWEST;
-            best_cost = cost;
-        }
-    }
-
-    // Check northeast
-    if (c->y - 1 > 0 && c->x + 1 < d->width && (c->behavior & TUNNELER || d->MAP(c->y - 1, c->x + 1).type != ROCK)) {
-        int cost = manhattan_distance(c->y - 1, c->x + 1, d->player->y, d->player->x);
-        if (cost < best_cost) {
-            direction = NORTHEAST;
-            best_cost = cost;
-        }
-    }
-
-    // Check southwest
-    if (c->y + 1 < d->height && c->x - 1 > 0 && (c->behavior & TUNNELER || d->MAP(c->y + 1, c->x - 1).type != ROCK)) {
-        int cost = manhattan_distance(c->y + 1, c->x - 1, d->player->y, d->player->x);
-        if (cost < best_cost) {
-            direction = SOUTHWEST;
-            best_cost = cost;
-        }
-    }
-
-    // Check southwest. Don't need to save cost because it's just used as a transient.
-    if (c->y + 1 < d->height && c->x + 1 < d->width &&
-        (c->behavior & TUNNELER || d->MAP(c->y + 1, c->x + 1).type != ROCK)) {
-        if (manhattan_distance(c->y + 1, c->x + 1, d->player->y, d->player->x) < best_cost) {
-            direction = SOUTHEAST;
-        }
-    }
-    #endif
-
     return direction;
 }
 
-// Helper that actually moves the monster in the direction given, and can do so without bounds checks or checking if the
-// move is valid, as the calculate_monster_moves() functions take care of that. Just need to make sure to rebuild cost
-// maps for the dungeons as necessary, and figure out if we killed another character
-static Character_T *do_character_move(Character_T *c, Direction_T direction) {
-    Dungeon_T *d;
-    Character_T *killed;
+// Helper that actually moves the character in the direction given, and can do so without bounds checks or checking if
+// the move is valid, as the calculate_monster_moves() functions take care of that. Just need to make sure to rebuild
+// cost maps for the dungeons as necessary, and figure out if we killed another character
+static Character_ID_T do_character_move(Dungeon_T *d, Character_ID_T id, Direction_T direction) {
+    Character_ID_T killed;
+    int *current_y, *current_x;
     int y, x;
 
-    // Define our dungeon as a variable so we can use macros
-    d = c->d;
+    // The PC and monsters keep their positions in different places
+    if (id == PC_CHARACTER) {
+        current_y = &d->player->y;
+        current_x = &d->player->x;
+    } else {
+        current_y = &d->monsters.y[id];
+        current_x = &d->monsters.x[id];
+    }
 
     // Start by building our new coordinates, or returning for the special case the monster is stuck
     switch (direction) { // NOLINT(hicpp-multiway-paths-covered)
         case NORTH:
-            y = c->y - 1;
-            x = c->x;
+            y = *current_y - 1;
+            x = *current_x;
             break;
         case SOUTH:
-            y = c->y + 1;
-            x = c->x;
+            y = *current_y + 1;
+            x = *current_x;
             break;
         case WEST:
-            y = c->y;
-            x = c->x - 1;
+            y = *current_y;
+            x = *current_x - 1;
             break;
         case EAST:
-            y = c->y;
-            x = c->x + 1;
+            y = *current_y;
+            x = *current_x + 1;
             break;
         case NORTHWEST:
-            y = c->y - 1;
-            x = c->x - 1;
+            y = *current_y - 1;
+            x = *current_x - 1;
             break;
         case NORTHEAST:
-            y = c->y - 1;
-            x = c->x + 1;
+            y = *current_y - 1;
+            x = *current_x + 1;
             break;
         case SOUTHWEST:
-            y = c->y + 1;
-            x = c->x - 1;
+            y = *current_y + 1;
+            x = *current_x - 1;
             break;
         case SOUTHEAST:
-            y = c->y + 1;
-            x = c->x + 1;
+            y = *current_y + 1;
+            x = *current_x + 1;
             break;
         case STUCK:
-            return NULL;
+            return NO_CHARACTER;
         default:
             bail(INVALID_STATE, "FATAL ERROR! DIJKSTRA FUNCTION CALLED WITH IMPOSSIBLE ENUM TYPE!");
     }
 
     // Assign the character in the target cell for returning later
-    killed = d->MAP(y, x).character;
+    killed = occupancy_get(&d->occupancy, y, x);
 
     // Check if the monster is trying to move into a cell where the hardness is not zero. If it is, subtract 85, and
     // move only if the monster can, rebuilding cost maps as necessary. Otherwise... don't move at all.
-    if (d->MAP(y, x).hardness != 0) {
-        d->MAP(y, x).hardness = d->MAP(y, x).hardness - 85 > 0 ? d->MAP(y, x).hardness - 85 : 0;
+    if (d->HARDNESS(y, x) != 0) {
+        d->HARDNESS(y, x) = d->HARDNESS(y, x) - 85 > 0 ? d->HARDNESS(y, x) - 85 : 0;
 
-        if (d->MAP(y, x).hardness == 0) {
-            d->MAP(y, x).type = CORRIDOR;
+        if (d->HARDNESS(y, x) == 0) {
+            d->TYPE(y, x) = CORRIDOR;
 
-            // Rebuild both cost maps since the dungeon was changed
+            // Rebuild both cost maps and what the player can see since the dungeon was changed
             build_dungeon_cost_maps(d, true, true);
+            build_dungeon_fov(d);
 
             // Update the dungeon
-            d->MAP(y, x).character = c;
-            d->MAP(c->y, c->x).character = NULL;
-            c->y = y;
-            c->x = x;
+            occupancy_set(&d->occupancy, *current_y, *current_x, NO_CHARACTER);
+            occupancy_set(&d->occupancy, y, x, id);
+            free_cells_remove(&d->free_cells, y, x);
+            free_cells_add(&d->free_cells, *current_y, *current_x);
+            if (id != PC_CHARACTER) {
+                spatial_move(&d->spatial, id, *current_y, *current_x, y, x);
+            }
+            *current_y = y;
+            *current_x = x;
         } else {
             build_dungeon_cost_maps(d, false, true);
+            return NO_CHARACTER;
         }
     } else {
 
         // Update the dungeon
-        d->MAP(y, x).character = c;
-        d->MAP(c->y, c->x).character = NULL;
-        c->y = y;
-        c->x = x;
+        occupancy_set(&d->occupancy, *current_y, *current_x, NO_CHARACTER);
+        occupancy_set(&d->occupancy, y, x, id);
+        free_cells_remove(&d->free_cells, y, x);
+        free_cells_add(&d->free_cells, *current_y, *current_x);
+        if (id != PC_CHARACTER) {
+            spatial_move(&d->spatial, id, *current_y, *current_x, y, x);
+        }
+        *current_y = y;
+        *current_x = x;
+    }
+
+    // What the player can see, how far everything is from them, and which room's cells are theirs changes whenever they
+    // actually move. Rebuilding the cost maps throws out the flee maps too, so those get rebuilt at most once a player
+    // move.
+    if (id == PC_CHARACTER) {
+        build_dungeon_cost_maps(d, true, true);
+        build_dungeon_fov(d);
+        free_cells_set_player_room(&d->free_cells, d, find_player_room(d));
     }
 
     return killed;
 }
 
+// Template for the whole turn of one type of monster. Behavior is a constant in every copy, so each one only has the
+// branches its type of monster can actually take, and calls the walking or tunneling helpers directly.
+//
+// If the monster is intelligent and telepathic, we can just use the current dungeon cost map. If the monster is only
+// intelligent we need to do some checking. First see if the monster can see the player; if it can we just use the
+// dungeon cost map and update the last seen position. If not, we check the edge cases where it's the monster's first
+// turn, or it's already at the spot where it last saw the PC. Otherwise, we build a cost map around the last seen spot,
+// and move towards there. If the monster is unintelligent but telepathic, or can see the player, move in a straight
+// line towards them. Otherwise, it wanders. Erratic monsters wander half of the time no matter what.
+#define MONSTER_MOVE_TEMPLATE(behavior) \
+static Character_ID_T move_monster_##behavior(Dungeon_T *d, Character_ID_T id) { \
+    Direction_T direction; \
+    int y, x; \
+\
+    y = d->monsters.y[id]; \
+    x = d->monsters.x[id]; \
+\
+    if ((behavior) & INTELLIGENT) { \
+        const int *cost; \
+        int *built; \
+\
+        cost = (behavior) & TUNNELER ? d->tunnel_cost : d->regular_cost; \
+        built = NULL; \
+        if (!((behavior) & TELEPATHIC)) { \
+            if (can_see_player(d, id)) { \
+                d->monsters.last_y[id] = d->player->y; \
+                d->monsters.last_x[id] = d->player->x; \
+            } else if (d->monsters.last_y[id] == -1 && d->monsters.last_x[id] == -1) { \
+                d->monsters.last_y[id] = y; \
+                d->monsters.last_x[id] = x; \
+                return NO_CHARACTER; \
+            } else if (y == d->monsters.last_y[id] && x == d->monsters.last_x[id]) { \
+                return NO_CHARACTER; \
+            } else { \
+                int sources[1][2]; \
+\
+                /* The map is only good for this move, so it's thrown away right after */ \
+                sources[0][0] = d->monsters.last_y[id]; \
+                sources[0][1] = d->monsters.last_x[id]; \
+                built = generate_dijkstra_map(d, 1, (int *) sources, CHARACTER_DIAGONAL_TRAVEL, \
+                                              (behavior) & TUNNELER ? TUNNEL_MAP : REGULAR_MAP); \
+                cost = built; \
+            } \
+        } \
+\
+        if ((behavior) & ERRATIC && random_bool(&d->random)) { \
+            direction = (behavior) & TUNNELER ? calculate_random_tunnel(d, y, x) : calculate_random_walk(d, y, x); \
+        } else { \
+            direction = calculate_intelligent_monster_move(d, y, x, cost); \
+        } \
+        free(built); \
+        return do_character_move(d, id, direction); \
+    } \
+\
+    if ((behavior) & TELEPATHIC || can_see_player(d, id)) { \
+        if ((behavior) & ERRATIC && random_bool(&d->random)) { \
+            direction = (behavior) & TUNNELER ? calculate_random_tunnel(d, y, x) : calculate_random_walk(d, y, x); \
+        } else { \
+            direction = (behavior) & TUNNELER ? calculate_straight_tunnel(d, y, x) : calculate_straight_walk(d, y, x); \
+        } \
+        return do_character_move(d, id, direction); \
+    } \
+\
+    direction = (behavior) & TUNNELER ? calculate_random_tunnel(d, y, x) : calculate_random_walk(d, y, x); \
+    return do_character_move(d, id, direction); \
+}
+
+// Stamp out a turn for every type of monster, and a table to pick between them by behavior
+#define MONSTER_TYPES(X) \
+    X(0) X(1) X(2) X(3) X(4) X(5) X(6) X(7) X(8) X(9) X(10) X(11) X(12) X(13) X(14) X(15)
+
+MONSTER_TYPES(MONSTER_MOVE_TEMPLATE)
+
+#define MONSTER_MOVE_ENTRY(behavior) move_monster_##behavior,
+static const Monster_Move_T monster_moves[NUM_MONSTER_TYPES] = {MONSTER_TYPES(MONSTER_MOVE_ENTRY)};
 
 // See character.h
-Character_T *new_character(Dungeon_T *d, int y, int x, int speed, int behavior, char symbol, char *color, bool player) {
+Character_T *new_character(int y, int x, int speed, char symbol, Color_T color) {
     Character_T *c = safe_malloc(sizeof(Character_T));
-    c->d = d;
     c->y = y;
     c->x = x;
-    c->last_y = -1;
-    c->last_x = -1;
     c->speed = speed;
-    c->behavior = behavior;
     c->symbol = symbol;
     c->color = color;
-    c->player = player;
-    c->cost = NULL;
     return c;
 }
 
 // See character.h
-void build_character_cost_map(Character_T *c, int num_sources, int sources[][2]) {
-    free(c->cost);
-    c->cost = generate_dijkstra_map(c->d, num_sources, (int *) sources, CHARACTER_DIAGONAL_TRAVEL,
-                                    c->behavior & TUNNELER ? TUNNEL_MAP : REGULAR_MAP);
+void init_monsters(Monsters_T *m) {
+    m->y = NULL;
+    m->x = NULL;
+    m->last_y = NULL;
+    m->last_x = NULL;
+    m->speed = NULL;
+    m->behavior = NULL;
+    m->move = NULL;
+    m->alive = NULL;
+    m->count = 0;
+    m->capacity = 0;
 }
 
-Character_T *move_monster(Character_T *c) {
-    Dungeon_T *d = c->d;
-    Direction_T direction;
-    Character_T *killed;
-
-    // If the monster is intelligent and telepathic, we can just use the current dungeon cost map
-    if (c->behavior & INTELLIGENT && c->behavior & TELEPATHIC) {
-        c->cost = c->behavior & TUNNELER ? d->tunnel_cost : d->regular_cost;
-        direction = calculate_intelligent_monster_move(c);
-        killed = do_character_move(c, direction);
-        c->cost = NULL;
-        return killed;
-    }
-
-    // If the monster is intelligent we need to do some checking. First see if the monster can see the player; if it can
-    // we just use the dungeon cost map and update the last seen position. If not, we check the edge cases where it's
-    // the monster's first turn, or it's already at the spot where it last saw the PC. Otherwise, we build a cost map
-    // around the last seen spot, and move towards there.
-    if (c->behavior & INTELLIGENT) {
-        if (can_see_player(c)) {
-            c->last_y = d->player->y;
-            c->last_x = d->player->x;
-            c->cost = c->behavior & TUNNELER ? d->tunnel_cost : d->regular_cost;
-            direction = calculate_intelligent_monster_move(c);
-            killed = do_character_move(c, direction);
-            c->cost = NULL;
-            return killed;
-
-        } else if (c->last_y == -1 && c->last_x == -1) {
-            c->last_y = c->y;
-            c->last_x = c->x;
-            return NULL;
-
-        } else if (c->y == c->last_y && c->x == c->last_x) {
-            return NULL;
-
-        } else {
-
-            // We have to build a cost map always, dungeons may change since the last time the character was up.
-            int sources[1][2];
-
-            sources[0][0] = c->last_y;
-            sources[0][1] = c->last_x;
+// See character.h
+void reserve_monsters(Monsters_T *m, int capacity) {
+    if (capacity <= m->capacity) {
+        return;
+    }
+
+    m->y = safe_realloc(m->y, capacity * sizeof(int));
+    m->x = safe_realloc(m->x, capacity * sizeof(int));
+    m->last_y = safe_realloc(m->last_y, capacity * sizeof(int));
+    m->last_x = safe_realloc(m->last_x, capacity * sizeof(int));
+    m->speed = safe_realloc(m->speed, capacity * sizeof(int));
+    m->behavior = safe_realloc(m->behavior, capacity * sizeof(int));
+    m->move = safe_realloc(m->move, capacity * sizeof(Monster_Move_T));
+    m->alive = safe_realloc(m->alive, capacity * sizeof(bool));
+    m->capacity = capacity;
+}
 
-            build_character_cost_map(c, 1, sources);
+// See character.h
+Character_ID_T add_monster(Monsters_T *m, int y, int x, int speed, int behavior) {
 
-            direction = calculate_intelligent_monster_move(c);
-            return do_character_move(c, direction);
-        }
+    // Grow by doubling if the caller didn't reserve enough room
+    if (m->count == m->capacity) {
+        reserve_monsters(m, m->capacity > 0 ? m->capacity * 2 : 1);
     }
 
-    // If the monster is unintelligent but telepathic, or can see the player, move in a straight line towards them
-    if (c->behavior & TELEPATHIC || can_see_player(c)) {
-        direction = calculate_unintelligent_monster_move(c);
-        return do_character_move(c, direction);
-    }
+    m->y[m->count] = y;
+    m->x[m->count] = x;
+    m->last_y[m->count] = -1;
+    m->last_x[m->count] = -1;
+    m->speed[m->count] = speed;
+    m->behavior[m->count] = behavior;
+    m->move[m->count] = monster_moves[behavior];
+    m->alive[m->count] = true;
+    m->count++;
 
-    // Monster needs to wander now
-    direction = calculate_random_move(c);
-    return do_character_move(c, direction);
+    return m->count - 1;
 }
 
 // See character.h
-Character_T *move_player(Character_T *c) {
-    return NULL;
+Character_ID_T move_monster(Dungeon_T *d, Character_ID_T id) {
+    return d->monsters.move[id](d, id);
 }
 
 // See character.h
-int find_player_room(Dungeon_T *d, Character_T *c) {
-    int r;
-
-    // Iterate through our rooms, searching them one by one
-    for (r = 0; r < d->num_rooms; r++) {
-        int i, j;
-
-        for (i = d->rooms[r].y; i < d->rooms[r].y + d->rooms[r].height; i++) {
-            for (j = d->rooms[r].x; j < d->rooms[r].x + d->rooms[r].width; j++) {
-                if (d->MAP(i, j).character == c) {
-                    return r;
-                }
-            }
-        }
-    }
+Character_ID_T move_player(Dungeon_T *d) {
+    return NO_CHARACTER;
+}
 
-    return -1;
+// See character.h
+int find_player_room(const Dungeon_T *d) {
+    return d->ROOM_ID(d->player->y, d->player->x) == NO_ROOM ? -1 : (int) d->ROOM_ID(d->player->y, d->player->x);
 }
 
 // See character.h
 char monster_behavior_char(int behavior) {
-    switch (behavior) {
-        case 0:
-            return MONSTER_0_CHAR;
-        case 1:
-            return MONSTER_1_CHAR;
-        case 2:
-            return MONSTER_2_CHAR;
-        case 3:
-            return MONSTER_3_CHAR;
-        case 4:
-            return MONSTER_4_CHAR;
-        case 5:
-            return MONSTER_5_CHAR;
-        case 6:
-            return MONSTER_6_CHAR;
-        case 7:
-            return MONSTER_7_CHAR;
-        case 8:
-            return MONSTER_8_CHAR;
-        case 9:
-            return MONSTER_9_CHAR;
-        case 10:
-            return MONSTER_10_CHAR;
-        case 11:
-            return MONSTER_11_CHAR;
-        case 12:
-            return MONSTER_12_CHAR;
-        case 13:
-            return MONSTER_13_CHAR;
-        case 14:
-            return MONSTER_14_CHAR;
-        case 15:
-            return MONSTER_15_CHAR;
-        default:
-            return '?';
-    }
+    return 0 <= behavior && behavior < NUM_MONSTER_TYPES ? monster_chars[behavior] : '?';
 }
 
-char *monster_behavior_color(int behavior) {
-    switch (behavior) {
-        case 0:
-            return MONSTER_0_COLOR;
-        case 1:
-            return MONSTER_1_COLOR;
-        case 2:
-            return MONSTER_2_COLOR;
-        case 3:
-            return MONSTER_3_COLOR;
-        case 4:
-            return MONSTER_4_COLOR;
-        case 5:
-            return MONSTER_5_COLOR;
-        case 6:
-            return MONSTER_6_COLOR;
-        case 7:
-            return MONSTER_7_COLOR;
-        case 8:
-            return MONSTER_8_COLOR;
-        case 9:
-            return MONSTER_9_COLOR;
-        case 10:
-            return MONSTER_10_COLOR;
-        case 11:
-            return MONSTER_11_COLOR;
-        case 12:
-            return MONSTER_12_COLOR;
-        case 13:
-            return MONSTER_13_COLOR;
-        case 14:
-            return MONSTER_14_COLOR;
-        case 15:
-            return MONSTER_15_COLOR;
-        default:
-            return CONSOLE_RESET;
-    }
+// See character.h
+Color_T monster_behavior_color(int behavior) {
+    return 0 <= behavior && behavior < NUM_MONSTER_TYPES ? monster_colors[behavior] : NO_COLOR;
 }
 
 // See character.h
 void cleanup_character(Character_T *c) {
-    if (c != NULL && c->cost != c->d->regular_cost && c->cost != c->d->tunnel_cost) {
-        free(c->cost);
-    }
     free(c);
 }
+
+// See character.h
+void cleanup_monsters(Monsters_T *m) {
+    free(m->y);
+    free(m->x);
+    free(m->last_y);
+    free(m->last_x);
+    free(m->speed);
+    free(m->behavior);
+    free(m->move);
+    free(m->alive);
+}
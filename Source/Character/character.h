@@ -3,6 +3,8 @@
 
 #include <stdbool.h>
 
+#include "Helpers/helpers.h"
+
 // See character.c for helper functions
 
 // Forward declare so we don't have to include the dungeon header
@@ -16,39 +18,68 @@ typedef enum Behavior_E {
     ERRATIC = 1 << 3
 } Behavior_T;
 
-// Struct for a character. Will be used for player and monster.
+// How many different types of monsters there are: one for every combination of behaviors
+#define NUM_MONSTER_TYPES (1 << 4)
+
+// Handle to a character standing in the dungeon. Monsters are referred to by their id in the monster store, which never
+// changes for as long as the dungeon lives, even after they die. The PC and empty cells get their own special values.
+typedef int Character_ID_T;
+#define NO_CHARACTER (-1)
+#define PC_CHARACTER (-2)
+
+// Struct for the player character. Monsters live in the monster store below instead.
 typedef struct Character_S {
-    Dungeon_T *d;
-    int y, x, last_y, last_x, speed, behavior;
+    int y, x, speed;
     char symbol;
-    char *color;
-    bool player;
-    int *cost;
+    Color_T color;
 } Character_T;
 
-// Returns a pointer to a new character. May be made static later. Simply initializes the above. Make sure to update
-// this function when extending the above struct
-Character_T *new_character(Dungeon_T *d, int y, int x, int speed, int behavior, char symbol, char *color, bool player);
+// A monster's whole turn. There's one for every type of monster, each built to only check for what that type can do.
+typedef Character_ID_T (*Monster_Move_T)(Dungeon_T *d, Character_ID_T id);
+
+// Every monster in the dungeon, stored as a structure of arrays indexed by monster id. The AI only ever touches a few
+// fields of each monster at a time, so keeping every field in its own dense array means those loops walk straight
+// through memory instead of chasing a pointer per monster. Dead monsters keep their slot, with alive set to false, so
+// ids stay stable. How they're printed is looked up off of behavior, so it isn't stored. Which turn function a monster
+// uses is picked once, when it's added, so moving never has to look at its behavior bits.
+typedef struct Monsters_S {
+    int *y, *x, *last_y, *last_x, *speed, *behavior;
+    Monster_Move_T *move;
+    bool *alive;
+    int count, capacity;
+} Monsters_T;
 
-// Builds a dijkstra cost map for a character to use
-void build_character_cost_map(Character_T *c, int num_sources, int sources[][2]);
+// Returns a pointer to a new player character. Make sure to update this function when extending the above struct
+Character_T *new_character(int y, int x, int speed, char symbol, Color_T color);
 
-// Process a move for a monster, returning the character it killed, if any
-Character_T *move_monster(Character_T *c);
+// Initializes an empty monster store
+void init_monsters(Monsters_T *m);
+
+// Makes sure there's room for capacity monsters in the store, so adding them never has to reallocate
+void reserve_monsters(Monsters_T *m, int capacity);
+
+// Adds a monster to the store, returning its id. Its last seen position starts off unknown.
+Character_ID_T add_monster(Monsters_T *m, int y, int x, int speed, int behavior);
+
+// Process a move for a monster with the turn function picked for it, returning the character it killed, if any
+Character_ID_T move_monster(Dungeon_T *d, Character_ID_T id);
 
 // Process a move for the player, returning the character killed, if any
-Character_T *move_player(Character_T *c);
+Character_ID_T move_player(Dungeon_T *d);
 
-// Find which room of the dungeon a character is in. Returns -1 if it can't find it.
-int find_player_room(Dungeon_T *d, Character_T *c);
+// Find which room of the dungeon the player is in, off of the room id plane. Returns -1 if they aren't in one.
+int find_player_room(const Dungeon_T *d);
 
 // Returns the char associated with a type of monster
 char monster_behavior_char(int behavior);
 
-// Returns the ASCI control string to color a cell type
-char *monster_behavior_color(int behavior);
+// Returns the color associated with a type of monster
+Color_T monster_behavior_color(int behavior);
 
-// Cleans up a character, freeing the cost maps they may have.
+// Cleans up a character
 void cleanup_character(Character_T *c);
 
+// Frees every array in the monster store, but not the store itself
+void cleanup_monsters(Monsters_T *m);
+
 #endif //ROGUE_CHARACTER_H
@@ -0,0 +1,178 @@
+#include <stdlib.h>
+#include <limits.h>
+
+#include "spatial.h"
+
+#include "Helpers/helpers.h"
+
+// Helper that returns the index of the bucket a cell falls into
+static int bucket_of(const Spatial_T *s, int y, int x) {
+    return (y / s->block) * s->columns + x / s->block;
+}
+
+// Helper that returns how many moves it takes to get between two cells, when diagonal moves are allowed
+static int moves_between(int y1, int x1, int y2, int x2) {
+    return abs(y1 - y2) > abs(x1 - x2) ? abs(y1 - y2) : abs(x1 - x2);
+}
+
+// Helper that links a monster onto the front of a bucket's list
+static void link_monster(Spatial_T *s, Character_ID_T id, int bucket) {
+    s->prev[id] = NO_CHARACTER;
+    s->next[id] = s->heads[bucket];
+    if (s->heads[bucket] != NO_CHARACTER) {
+        s->prev[s->heads[bucket]] = id;
+    }
+    s->heads[bucket] = id;
+}
+
+// Helper that unlinks a monster from a bucket's list
+static void unlink_monster(Spatial_T *s, Character_ID_T id, int bucket) {
+    if (s->prev[id] != NO_CHARACTER) {
+        s->next[s->prev[id]] = s->next[id];
+    } else {
+        s->heads[bucket] = s->next[id];
+    }
+    if (s->next[id] != NO_CHARACTER) {
+        s->prev[s->next[id]] = s->prev[id];
+    }
+}
+
+// See spatial.h
+void init_spatial(Spatial_T *s, int height, int width, int block) {
+    int i;
+
+    s->block = block;
+    s->rows = (height + block - 1) / block;
+    s->columns = (width + block - 1) / block;
+    s->capacity = 0;
+    s->next = NULL;
+    s->prev = NULL;
+
+    // Every bucket starts off empty
+    s->heads = safe_malloc(s->rows * s->columns * sizeof(Character_ID_T));
+    for (i = 0; i < s->rows * s->columns; i++) {
+        s->heads[i] = NO_CHARACTER;
+    }
+}
+
+// See spatial.h
+void spatial_insert(Spatial_T *s, Character_ID_T id, int y, int x) {
+
+    // Make room for the links of this id, doubling so a run of inserts stays cheap
+    if (id >= s->capacity) {
+        while (id >= s->capacity) {
+            s->capacity = s->capacity > 0 ? s->capacity * 2 : 1;
+        }
+        s->next = safe_realloc(s->next, s->capacity * sizeof(Character_ID_T));
+        s->prev = safe_realloc(s->prev, s->capacity * sizeof(Character_ID_T));
+    }
+
+    link_monster(s, id, bucket_of(s, y, x));
+}
+
+// See spatial.h
+void spatial_remove(Spatial_T *s, Character_ID_T id, int y, int x) {
+    unlink_monster(s, id, bucket_of(s, y, x));
+}
+
+// See spatial.h
+void spatial_move(Spatial_T *s, Character_ID_T id, int from_y, int from_x, int y, int x) {
+    int from, to;
+
+    from = bucket_of(s, from_y, from_x);
+    to = bucket_of(s, y, x);
+    if (from != to) {
+        unlink_monster(s, id, from);
+        link_monster(s, id, to);
+    }
+}
+
+// See spatial.h
+int spatial_query_radius(const Spatial_T *s, const Monsters_T *m, int y, int x, int radius, Character_ID_T *found,
+                         int max) {
+    int top, bottom, left, right, i, j, count;
+
+    // Work out which buckets the square around the cell touches, staying inside of the grid
+    top = y - radius < 0 ? 0 : (y - radius) / s->block;
+    bottom = (y + radius) / s->block >= s->rows ? s->rows - 1 : (y + radius) / s->block;
+    left = x - radius < 0 ? 0 : (x - radius) / s->block;
+    right = (x + radius) / s->block >= s->columns ? s->columns - 1 : (x + radius) / s->block;
+
+    // Walk each bucket's list, keeping anyone close enough
+    count = 0;
+    for (i = top; i <= bottom; i++) {
+        for (j = left; j <= right; j++) {
+            Character_ID_T id;
+
+            for (id = s->heads[i * s->columns + j]; id != NO_CHARACTER; id = s->next[id]) {
+                if (moves_between(y, x, m->y[id], m->x[id]) <= radius) {
+                    if (count < max) {
+                        found[count] = id;
+                    }
+                    count++;
+                }
+            }
+        }
+    }
+
+    return count;
+}
+
+// See spatial.h
+Character_ID_T spatial_nearest(const Spatial_T *s, const Monsters_T *m, int y, int x) {
+    Character_ID_T best;
+    int best_distance, center_y, center_x, ring, rings;
+
+    best = NO_CHARACTER;
+    best_distance = INT_MAX;
+    center_y = y / s->block;
+    center_x = x / s->block;
+    rings = s->rows > s->columns ? s->rows : s->columns;
+
+    // Search outwards a ring of buckets at a time. Anything in a bucket ring r away is at least (r - 1) * block + 1
+    // moves away, so once we've found something closer than that there's no point looking any further.
+    for (ring = 0; ring < rings; ring++) {
+        int i;
+
+        if (ring > 0 && best_distance <= (ring - 1) * s->block + 1) {
+            break;
+        }
+
+        for (i = center_y - ring; i <= center_y + ring; i++) {
+            int j, step;
+
+            if (i < 0 || i >= s->rows) {
+                continue;
+            }
+
+            // The top and bottom rows of the ring are walked all the way across, the rest only have their two ends
+            step = i == center_y - ring || i == center_y + ring ? 1 : 2 * ring;
+            for (j = center_x - ring; j <= center_x + ring; j += step > 0 ? step : 1) {
+                Character_ID_T id;
+
+                if (j < 0 || j >= s->columns) {
+                    continue;
+                }
+
+                for (id = s->heads[i * s->columns + j]; id != NO_CHARACTER; id = s->next[id]) {
+                    int distance;
+
+                    distance = moves_between(y, x, m->y[id], m->x[id]);
+                    if (distance < best_distance) {
+                        best = id;
+                        best_distance = distance;
+                    }
+                }
+            }
+        }
+    }
+
+    return best;
+}
+
+// See spatial.h
+void cleanup_spatial(Spatial_T *s) {
+    free(s->heads);
+    free(s->next);
+    free(s->prev);
+}
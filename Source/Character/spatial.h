@@ -0,0 +1,45 @@
+#ifndef ROGUE_SPATIAL_H
+#define ROGUE_SPATIAL_H
+
+#include "character.h"
+
+// See spatial.c for helper functions
+
+// A uniform grid over the dungeon, for finding monsters by where they are instead of scanning the whole store. The
+// dungeon is cut into block x block buckets, and each bucket keeps a doubly linked list of the monsters standing in it.
+// The links are stored by monster id in next and prev, so the lists are intrusive and moving a monster between buckets
+// is a couple of array writes, never an allocation. Queries only look at the buckets that overlap what they're asking
+// about, so they cost about as much as the number of monsters they find, plus a few empty buckets.
+//
+// Distances are measured in moves, so diagonal steps count as one (Chebyshev distance).
+typedef struct Spatial_S {
+    int block, rows, columns, capacity;
+    Character_ID_T *heads;
+    Character_ID_T *next, *prev;
+} Spatial_T;
+
+// Initializes an empty index for a dungeon of the given size, with buckets block cells on a side
+void init_spatial(Spatial_T *s, int height, int width, int block);
+
+// Adds a monster standing at (y, x) to the index
+void spatial_insert(Spatial_T *s, Character_ID_T id, int y, int x);
+
+// Removes a monster standing at (y, x) from the index
+void spatial_remove(Spatial_T *s, Character_ID_T id, int y, int x);
+
+// Updates the index for a monster that moved from (from_y, from_x) to (y, x). Nothing happens unless it crossed into a
+// different bucket.
+void spatial_move(Spatial_T *s, Character_ID_T id, int from_y, int from_x, int y, int x);
+
+// Finds every monster within radius moves of (y, x), storing up to max of their ids in found. Returns how many were
+// found, which may be more than max if found was too small.
+int spatial_query_radius(const Spatial_T *s, const Monsters_T *m, int y, int x, int radius, Character_ID_T *found,
+                         int max);
+
+// Returns the monster closest to (y, x), or NO_CHARACTER if there aren't any. Ties go to whichever is found first.
+Character_ID_T spatial_nearest(const Spatial_T *s, const Monsters_T *m, int y, int x);
+
+// Frees the index, but not the index itself
+void cleanup_spatial(Spatial_T *s);
+
+#endif //ROGUE_SPATIAL_H
@@ -0,0 +1,136 @@
+// We have to include this macro so gcc shuts up and will actually compile
+// I think this is what I get for wanting to compile against C11
+#define _POSIX_C_SOURCE 200809L // NOLINT(bugprone-reserved-identifier)
+
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Check if we are on Windows or *nix to include the correct director to make directories
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
+#include "dungeon-batch.h"
+#include "dungeon-disk.h"
+
+#include "Dungeon/dungeon.h"
+#include "Helpers/helpers.h"
+#include "Helpers/pacer.h"
+#include "Settings/exit-codes.h"
+#include "Settings/file-settings.h"
+
+// Longest a seed can be written out in decimal
+#define MAX_SEED_DIGITS 20
+
+// Work shared between every worker. The only thing that changes is next, the index of the next dungeon nobody has
+// claimed yet, so that's all the lock guards.
+typedef struct Batch_S {
+    pthread_mutex_t lock;
+    int next, count, height, width;
+    uint64_t seed;
+    const char *dir;
+} Batch_T;
+
+// Helper that claims the next dungeon to build, or returns -1 once they're all claimed
+static int claim_dungeon(Batch_T *b) {
+    int i;
+
+    pthread_mutex_lock(&b->lock);
+    i = b->next < b->count ? b->next++ : -1;
+    pthread_mutex_unlock(&b->lock);
+
+    return i;
+}
+
+// Thread that keeps building and saving dungeons until there are none left. Each dungeon gets its own random generator
+// and memory from new_unpopulated_dungeon(), and the path is built in a buffer only this worker touches, so nothing
+// else needs a lock.
+static void *generate_thread(void *arg) {
+    Batch_T *b;
+    char *path;
+    size_t length;
+    int i;
+
+    b = arg;
+
+    // Room for <dir>/<name>-<seed>.pgm and the null terminator
+    length = strlen(b->dir) + strlen(GENERATE_FILE_PREFIX) + strlen(GENERATE_PGM_EXTENSION) + MAX_SEED_DIGITS + 3;
+    path = safe_malloc(length);
+
+    while ((i = claim_dungeon(b)) != -1) {
+        Dungeon_T *d;
+        uint64_t seed;
+
+        seed = b->seed + (uint64_t) i;
+        d = new_unpopulated_dungeon(b->height, b->width, seed);
+
+        snprintf(path, length, "%s/%s-%" PRIu64, b->dir, GENERATE_FILE_PREFIX, seed);
+        save_dungeon(d, path);
+        snprintf(path, length, "%s/%s-%" PRIu64 "%s", b->dir, GENERATE_FILE_PREFIX, seed, GENERATE_PGM_EXTENSION);
+        save_pgm(d, path);
+
+        cleanup_dungeon(d);
+    }
+
+    free(path);
+    return NULL;
+}
+
+// See dungeon-batch.h
+void generate_dungeon_batch(int count, uint64_t seed, int height, int width, const char *dir, int threads) {
+    struct timespec start, end;
+    pthread_t *workers;
+    Batch_T b;
+    double seconds;
+    int i;
+
+    // Make the directory if it doesn't exist. Same as the save directory, it can't make more than the last one.
+    #if defined(_WIN32)
+    _mkdir(dir);
+    #else
+    mkdir(dir, 0700);
+    #endif
+
+    // No point starting workers that would never get a dungeon
+    if (threads > count) {
+        threads = count;
+    }
+
+    b.next = 0;
+    b.count = count;
+    b.height = height;
+    b.width = width;
+    b.seed = seed;
+    b.dir = dir;
+    if (pthread_mutex_init(&b.lock, NULL) != 0) {
+        bail(INVALID_STATE, "FATAL ERROR! FAILED TO SET UP THE GENERATOR LOCK!\n");
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    // Start every worker and wait for them to run out of dungeons
+    workers = safe_malloc(threads * sizeof(pthread_t));
+    for (i = 0; i < threads; i++) {
+        if (pthread_create(&workers[i], NULL, &generate_thread, &b) != 0) {
+            bail(INVALID_STATE, "FATAL ERROR! FAILED TO START A GENERATOR THREAD!\n");
+        }
+    }
+    for (i = 0; i < threads; i++) {
+        pthread_join(workers[i], NULL);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    seconds = (double) time_difference(&end, &start) / NANOSECONDS;
+    fprintf(stderr, "Generated %i dungeons (seeds %" PRIu64 " to %" PRIu64 ") into %s with %i threads in %.3fs"
+                    " (%.1f dungeons/s)\n", count, seed, seed + (uint64_t) count - 1, dir, threads, seconds,
+            seconds > 0 ? count / seconds : 0);
+
+    free(workers);
+    pthread_mutex_destroy(&b.lock);
+}
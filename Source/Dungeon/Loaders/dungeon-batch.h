@@ -0,0 +1,14 @@
+#ifndef ROGUE_DUNGEON_BATCH_H
+#define ROGUE_DUNGEON_BATCH_H
+
+#include <stdint.h>
+
+// See dungeon-batch.c for helper functions
+
+// Generates count height x width dungeons off of the seeds seed, seed + 1, ... and saves each one into dir, both as a
+// saved dungeon named dungeon-<seed> and as a PGM named dungeon-<seed>.pgm. The work is split between threads workers,
+// which each take the next seed as they finish one. Every dungeon has its own random generator, so the dungeon a seed
+// makes is the same no matter how many threads there are, or what order they run in. Prints how long it took to stderr.
+void generate_dungeon_batch(int count, uint64_t seed, int height, int width, const char *dir, int threads);
+
+#endif //ROGUE_DUNGEON_BATCH_H
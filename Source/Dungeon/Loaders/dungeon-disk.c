@@ -2,20 +2,13 @@
 #include <string.h>
 #include <stdlib.h>
 
-// Make use of endian functions in the host system. Better than anything we can probably code. Need a compile time
-// conditional so we load the windows variant or the *nix variant.
-#ifdef _WIN32
-#include <winsock.h>
-#else
-#include <arpa/inet.h>
-#endif
-
 #include "dungeon-disk.h"
 
 #include "dungeon-random.h"
 #include "Dungeon/dungeon.h"
 #include "Character/character.h"
 #include "Helpers/helpers.h"
+#include "Helpers/random.h"
 #include "Settings/character-settings.h"
 #include "Settings/dungeon-settings.h"
 #include "Settings/print-settings.h"
@@ -33,36 +26,36 @@ static void place_stairs(Dungeon_T *d) {
 
         // Up stairs
         do {
-            r = rand_int_in_range(0, d->num_rooms - 1);
+            r = random_int_in_range(&d->random, 0, d->num_rooms - 1);
         } while (d->rooms[r].y == d->player->y && d->rooms[r].x == d->player->x);
-        d->MAP(d->rooms[r].y, d->rooms[r].x).type = STAIR_UP;
+        d->TYPE(d->rooms[r].y, d->rooms[r].x) = STAIR_UP;
 
         // Down stairs
         do {
-            r2 = rand_int_in_range(0, d->num_rooms - 1);
+            r2 = random_int_in_range(&d->random, 0, d->num_rooms - 1);
         } while ((d->rooms[r2].y == d->player->y && d->rooms[r2].x == d->player->x) || r == r2);
-        d->MAP(d->rooms[r2].y, d->rooms[r2].x).type = STAIR_DOWN;
+        d->TYPE(d->rooms[r2].y, d->rooms[r2].x) = STAIR_DOWN;
 
     } else if (d->num_rooms > 1) {
-        r = rand() % 2;  // NOLINT(cert-msc50-cpp)
+        r = random_bool(&d->random);
 
         // Randomly place up or down in the two available rooms
         if (r) {
-            d->MAP(d->rooms[0].y, d->rooms[0].x).type = STAIR_UP;
-            d->MAP(d->rooms[1].y, d->rooms[1].x).type = STAIR_DOWN;
+            d->TYPE(d->rooms[0].y, d->rooms[0].x) = STAIR_UP;
+            d->TYPE(d->rooms[1].y, d->rooms[1].x) = STAIR_DOWN;
         } else {
-            d->MAP(d->rooms[0].y, d->rooms[0].x).type = STAIR_DOWN;
-            d->MAP(d->rooms[1].y, d->rooms[1].x).type = STAIR_UP;
+            d->TYPE(d->rooms[0].y, d->rooms[0].x) = STAIR_DOWN;
+            d->TYPE(d->rooms[1].y, d->rooms[1].x) = STAIR_UP;
         }
 
     } else {
-        r = rand() % 2;  // NOLINT(cert-msc50-cpp)
+        r = random_bool(&d->random);
 
         // Randomly place up or down stairs
         if (r) {
-            d->MAP(d->rooms[0].y, d->rooms[0].x).type = STAIR_UP;
+            d->TYPE(d->rooms[0].y, d->rooms[0].x) = STAIR_UP;
         } else {
-            d->MAP(d->rooms[0].y, d->rooms[0].x).type = STAIR_DOWN;
+            d->TYPE(d->rooms[0].y, d->rooms[0].x) = STAIR_DOWN;
         }
     }
 }
@@ -75,14 +68,16 @@ static void place_stairs(Dungeon_T *d) {
 // It starts off by reading the entire file into memory, bailing out if the file doesn't exist, we can't open it, or
 // the file size is greater then MAX_DUNGEON_FILE_SIZE. This is more efficient than reading a few bytes at a time. It
 // initializes an iterator (p) so we can step through the buffer safely, always making sure we are in bounds on the
-// array. First it checks the semantic of the file: the marker, version, and making sure the size matches. Then it
-// starts actually building the dungeon, stepping through the file entry by entry. If the stairs bool is true AND there
-// is no stairs in the dungeon yet, the loader will place some with the helper function.
-Dungeon_T *load_dungeon(const char *path, bool stairs) {
+// array. First it checks the semantic of the file: the marker, version, and making sure the size matches. The version
+// decides the size of the dungeon and how wide coordinates and counts are. Then it starts actually building the
+// dungeon, stepping through the file entry by entry. If the stairs bool is true AND there is no stairs in the dungeon
+// yet, the loader will place some with the helper function.
+Dungeon_T *load_dungeon(const char *path, bool stairs, int height, int width, uint64_t seed) {
     FILE *f;
-    int y, x, i, j, r;
+    int y, x, i, j, r, dungeon_height, dungeon_width, coordinate_bytes, count_bytes;
     unsigned char *buffer; // Stores array
     unsigned long long size, p; // p stores our buffer iterator
+    uint32_t version;
     Dungeon_T *d;
     bool placed_stairs;
 
@@ -100,8 +95,9 @@ Dungeon_T *load_dungeon(const char *path, bool stairs) {
 
     // Check if the file is bigger than the max. Bail out if it is. It's not going to be a valid file then.
     if (size > MAX_DUNGEON_FILE_SIZE) {
-        fprintf(stderr, "File is %llu bytes, bigger than maximum size of %i bytes! Using random dungeon!\n",
+        fprintf(stderr, "File is %llu bytes, bigger than maximum size of %llu bytes! Using random dungeon!\n",
                 size, MAX_DUNGEON_FILE_SIZE);
+        fclose(f);
         goto cleanup;
     }
 
@@ -138,10 +134,10 @@ Dungeon_T *load_dungeon(const char *path, bool stairs) {
         goto cleanup_buffer;
     }
 
-    // Check if the file version is correct.
-    // Ugly cast to grab than more one byte is needed. Need to do endian conversion.
-    if (ntohl(*(uint32_t *) &buffer[p]) != FILE_VERSION) {
-        fprintf(stderr, "Invalid file version %i! Using random dungeon!\n", ntohl(*(uint32_t *) &buffer[p]));
+    // Check if the file version is one we know.
+    version = (uint32_t) read_value(&buffer[p], sizeof(uint32_t));
+    if (version != FILE_VERSION && version != SIZED_FILE_VERSION) {
+        fprintf(stderr, "Invalid file version %u! Using random dungeon!\n", version);
         goto cleanup_buffer;
     }
     p += sizeof(uint32_t);
@@ -153,90 +149,124 @@ Dungeon_T *load_dungeon(const char *path, bool stairs) {
     }
 
     // Check if the file size matches the one reported by the OS.
-    // Ugly cast to grab than more one byte is needed. Need to do endian conversion.
-    if (ntohl(*(uint32_t *) &buffer[p]) != size) {
-        fprintf(stderr, "File size %i in file does not match OS file size of %llu! Using random dungeon!\n",
-                ntohl(*(uint32_t *) &buffer[p]), size);
+    if (read_value(&buffer[p], sizeof(uint32_t)) != size) {
+        fprintf(stderr, "File size %u in file does not match OS file size of %llu! Using random dungeon!\n",
+                (uint32_t) read_value(&buffer[p], sizeof(uint32_t)), size);
         goto cleanup_buffer;
     }
     p += sizeof(uint32_t);
 
+    // The original version is always the default size, with byte coordinates. The sized version says how big it is,
+    // and uses wider coordinates and counts to fit. Keep height and width for the random dungeon if this one is bad.
+    if (version == FILE_VERSION) {
+        dungeon_height = DUNGEON_HEIGHT;
+        dungeon_width = DUNGEON_WIDTH;
+        coordinate_bytes = sizeof(uint8_t);
+        count_bytes = sizeof(uint16_t);
+    } else {
+
+        // Check if we can read the dimensions without going out of bounds.
+        if (p + sizeof(uint16_t) * 2 > size) {
+            fprintf(stderr, "EOF! File is missing dungeon size info! Using random dungeon!\n");
+            goto cleanup_buffer;
+        }
+
+        // Check if the dimensions are ones we can generate and play
+        dungeon_height = (int) read_value(&buffer[p], sizeof(uint16_t));
+        dungeon_width = (int) read_value(&buffer[p + sizeof(uint16_t)], sizeof(uint16_t));
+        if (dungeon_height < MIN_DUNGEON_HEIGHT || dungeon_height > MAX_DUNGEON_HEIGHT ||
+            dungeon_width < MIN_DUNGEON_WIDTH || dungeon_width > MAX_DUNGEON_WIDTH) {
+            fprintf(stderr, "Invalid dungeon size %ix%i! Must be between %ix%i and %ix%i! Using random dungeon!\n",
+                    dungeon_width, dungeon_height, MIN_DUNGEON_WIDTH, MIN_DUNGEON_HEIGHT, MAX_DUNGEON_WIDTH,
+                    MAX_DUNGEON_HEIGHT);
+            goto cleanup_buffer;
+        }
+        p += sizeof(uint16_t) * 2;
+        coordinate_bytes = sizeof(uint16_t);
+        count_bytes = sizeof(uint32_t);
+    }
+
     // Allocate space for our dungeon and initialize it.
     d = safe_malloc(sizeof(Dungeon_T));
-    init_dungeon(d, DUNGEON_HEIGHT, DUNGEON_WIDTH);
+    init_dungeon(d, dungeon_height, dungeon_width, seed);
 
     // Check if we can read the player coordinates without going out bounds.
-    if (p + sizeof(uint8_t) * 2 > size) {
+    if (p + coordinate_bytes * 2 > size) {
         fprintf(stderr, "EOF! File is missing player location info! Using random dungeon!\n");
         goto cleanup_dungeon;
     }
 
     // Start building our dungeon... get player coordinates and save them for now.
-    x = buffer[p];
-    y = buffer[p + 1];
+    x = (int) read_value(&buffer[p], coordinate_bytes);
+    y = (int) read_value(&buffer[p + coordinate_bytes], coordinate_bytes);
 
     // Check if the player coordinate are in bounds on the dungeon map.
-    if (x >= DUNGEON_WIDTH && y >= DUNGEON_HEIGHT) {
+    if (x >= d->width || y >= d->height) {
         fprintf(stderr, "Out of range player coordinates: (%i, %i)! Using random dungeon!\n", x, y);
         goto cleanup_dungeon;
     }
-    p += sizeof(uint8_t) * 2;
+    p += coordinate_bytes * 2;
 
     // Check if we can read the dungeon map without going out of bounds
-    if (p + sizeof(uint8_t) * DUNGEON_HEIGHT * DUNGEON_WIDTH > size) {
+    if (p + sizeof(uint8_t) * d->height * d->width > size) {
         fprintf(stderr, "EOF! File is missing dungeon hardness info! Using random dungeon!\n");
         goto cleanup_dungeon;
     }
 
     // Get our dungeon map. Checks if any of the border cells are not max hardness and bails out if they aren't.
-    for (i = 0; i < DUNGEON_HEIGHT; i++) {
-        for (j = 0; j < DUNGEON_WIDTH; j++) {
-            if ((i == 0 || i == DUNGEON_HEIGHT - 1 || j == 0 || j == DUNGEON_WIDTH - 1) &&
+    for (i = 0; i < d->height; i++) {
+        for (j = 0; j < d->width; j++) {
+            if ((i == 0 || i == d->height - 1 || j == 0 || j == d->width - 1) &&
                 buffer[p] != IMMUTABLE_ROCK_HARDNESS) {
                 fprintf(stderr, "Border of the dungeon must be immutable (%i hardness)! Using random dungeon!\n",
                         IMMUTABLE_ROCK_HARDNESS);
                 goto cleanup_dungeon;
             }
             if (buffer[p] == 0) {
-                d->MAP(i, j).type = CORRIDOR;
-                d->MAP(i, j).hardness = 0;
+                d->TYPE(i, j) = CORRIDOR;
+                d->HARDNESS(i, j) = 0;
             } else {
-                d->MAP(i, j).type = ROCK;
-                d->MAP(i, j).hardness = buffer[p];
+                d->TYPE(i, j) = ROCK;
+                d->HARDNESS(i, j) = buffer[p];
             }
             p += sizeof(uint8_t);
         }
     }
 
     // Attempt to place our PC. Fail out if coords are not an open room.
-    if (d->MAP(y, x).type == ROCK) {
+    if (d->TYPE(y, x) == ROCK) {
         fprintf(stderr,
                 "Player cannot be in rock: (%i, %i)! Dungeon will be unplayable! Using random dungeon!\n", x, y);
         goto cleanup_dungeon;
     }
-    d->player = new_character(d, y, x, PC_SPEED, 0, PC_SYMBOL, PC_COLOR, true);
-    d->MAP(y, x).character = d->player;
+    d->player = new_character(y, x, PC_SPEED, PC_SYMBOL, PC_COLOR);
+    occupancy_set(&d->occupancy, y, x, PC_CHARACTER);
 
     // Check if we can read the number of rooms without going out of bounds.
-    if (p + sizeof(uint16_t) > size) {
+    if (p + count_bytes > size) {
         fprintf(stderr, "EOF! File is missing number of rooms! Using random dungeon!\n");
         goto cleanup_dungeon;
     }
 
     // Get how many rooms we have and store it into our dungeon. Make sure the number of rooms is greater than 0
-    // and warn if it's not that it won't be a good dungeon.
-    // Ugly cast to grab than more one byte is needed. Need to do endian conversion.
-    if (ntohs(*(uint16_t *) &buffer[p]) == 0) {
+    // and warn if it's not that it won't be a good dungeon. Rooms can't touch, so there can't be more than a room for
+    // every other cell.
+    if (read_value(&buffer[p], count_bytes) == 0) {
         fprintf(stderr,
                 "Dungeon does not have rooms and will be unplayable! Using random dungeon!\n");
         goto cleanup_dungeon;
     }
-    d->num_rooms = ntohs(*(uint16_t *) &buffer[p]);
+    if (read_value(&buffer[p], count_bytes) > (uint32_t) d->height * d->width / 2) {
+        fprintf(stderr, "Dungeon has too many rooms! There can be at most %i! Using random dungeon!\n",
+                d->height * d->width / 2);
+        goto cleanup_dungeon;
+    }
+    d->num_rooms = (int) read_value(&buffer[p], count_bytes);
     d->rooms = safe_malloc(d->num_rooms * sizeof(Room_T));
-    p += sizeof(uint16_t);
+    p += count_bytes;
 
     // Check if we can read the rooms without going out of bounds
-    if (p + d->num_rooms * 4 * sizeof(uint8_t) > size) {
+    if (p + (unsigned long long) d->num_rooms * 4 * coordinate_bytes > size) {
         fprintf(stderr, "EOF! File is missing room info! Using random dungeon!\n");
         goto cleanup_dungeon;
     }
@@ -244,58 +274,59 @@ Dungeon_T *load_dungeon(const char *path, bool stairs) {
     // Start building our rooms. Bail out if coordinate are not in range, or the hardness underneath has not been set
     // to zero. Iterate through each room.
     for (r = 0; r < d->num_rooms; r++) {
-        int width, height;
+        int room_width, room_height;
 
         // Read in the 4 parameters for a room
-        x = buffer[p];
-        y = buffer[p + 1];
-        width = buffer[p + 2];
-        height = buffer[p + 3];
+        x = (int) read_value(&buffer[p], coordinate_bytes);
+        y = (int) read_value(&buffer[p + coordinate_bytes], coordinate_bytes);
+        room_width = (int) read_value(&buffer[p + coordinate_bytes * 2], coordinate_bytes);
+        room_height = (int) read_value(&buffer[p + coordinate_bytes * 3], coordinate_bytes);
 
         // Check if the bounds of the room are valid and in range.
-        if (y + height > DUNGEON_HEIGHT - 1 || x + width > DUNGEON_WIDTH - 1) {
+        if (y + room_height > d->height - 1 || x + room_width > d->width - 1) {
             fprintf(stderr,
                     "Invalid room specified! (x: %i, y: %i, w: %i, h: %i)! Rooms must be in bounds! Using random dungeon!\n",
-                    x, y, width, height);
+                    x, y, room_width, room_height);
             goto cleanup_dungeon;
         }
 
         // Check if all cells covered by the room have zero hardness. Paint the cell as a room if it's a valid cell.
-        for (i = y; i < y + height; i++) {
-            for (j = x; j < x + width; j++) {
-                if (d->MAP(i, j).hardness != 0) {
+        for (i = y; i < y + room_height; i++) {
+            for (j = x; j < x + room_width; j++) {
+                if (d->HARDNESS(i, j) != 0) {
                     fprintf(stderr,
                             "Invalid room specified! (x: %i, y: %i, w: %i, h: %i)! Rooms must have 0 hardness! Using random dungeon!\n",
-                            x, y, width, height);
+                            x, y, room_width, room_height);
                     goto cleanup_dungeon;
                 }
-                d->MAP(i, j).type = ROOM;
+                d->TYPE(i, j) = ROOM;
             }
         }
 
         // Add the rooms to the array and increment.
         d->rooms[r].y = y;
         d->rooms[r].x = x;
-        d->rooms[r].height = height;
-        d->rooms[r].width = width;
-        p += 4 * sizeof(uint8_t);
+        d->rooms[r].height = room_height;
+        d->rooms[r].width = room_width;
+        mark_dungeon_room(d, r);
+        p += 4 * coordinate_bytes;
     }
 
     // Keep track if we placed stairs
     placed_stairs = false;
 
     // Check if we can read the number of upward stairs without going out of bounds.
-    if (p + sizeof(uint16_t) > size) {
+    if (p + count_bytes > size) {
         fprintf(stderr, "EOF! File is missing number of upwards staircases! Using random dungeon!\n");
         goto cleanup_dungeon;
     }
 
-    // Get our number of upwards stairs. Ugly cast to grab than more one byte is needed. Need to do endian conversion.
-    r = ntohs(*(uint16_t *) &buffer[p]);
-    p += sizeof(uint16_t);
+    // Get our number of upwards stairs.
+    r = (int) read_value(&buffer[p], count_bytes);
+    p += count_bytes;
 
     // Check if we can read the upwards stairs without going out of bounds.
-    if (p + r * sizeof(uint8_t) > size) {
+    if (r < 0 || p + (unsigned long long) r * 2 * coordinate_bytes > size) {
         fprintf(stderr, "EOF! File is missing upwards staircase info! Using random dungeon!\n");
         goto cleanup_dungeon;
     }
@@ -303,40 +334,39 @@ Dungeon_T *load_dungeon(const char *path, bool stairs) {
     // Place our upwards staircases, failing if the coordinate aren't in range or if they aren't in open space.
     // Iterate through each staircase.
     for (i = 0; i < r; i++) {
+        x = (int) read_value(&buffer[p], coordinate_bytes);
+        y = (int) read_value(&buffer[p + coordinate_bytes], coordinate_bytes);
 
         // Check if the room stair coordinate are in range
-        if (buffer[p + 1] > DUNGEON_HEIGHT - 1 || buffer[p] > DUNGEON_WIDTH - 1) {
-            fprintf(stderr,
-                    "Out of bounds upwards stairs (%i, %i)! Using random dungeon!\n",
-                    buffer[p], buffer[p + 1]);
+        if (y > d->height - 1 || x > d->width - 1) {
+            fprintf(stderr, "Out of bounds upwards stairs (%i, %i)! Using random dungeon!\n", x, y);
             goto cleanup_dungeon;
         }
 
         // Check if the stairs are in open space.
-        if (d->MAP(buffer[p + 1], buffer[p]).hardness != 0) {
-            fprintf(stderr, "Upwards staircases cannot be in rock (%i, %i)! Using random dungeon!\n",
-                    buffer[p], buffer[p + 1]);
+        if (d->HARDNESS(y, x) != 0) {
+            fprintf(stderr, "Upwards staircases cannot be in rock (%i, %i)! Using random dungeon!\n", x, y);
             goto cleanup_dungeon;
         }
 
         // Add the stair to the dungeon
-        d->MAP(buffer[p + 1], buffer[p]).type = STAIR_UP;
+        d->TYPE(y, x) = STAIR_UP;
         placed_stairs = true;
-        p += 2 * sizeof(uint8_t);
+        p += 2 * coordinate_bytes;
     }
 
     // Check if we can read the number of downward stairs without going out of bounds.
-    if (p + sizeof(uint16_t) > size) {
+    if (p + count_bytes > size) {
         fprintf(stderr, "EOF! File is missing number of downwards staircases! Using random dungeon!\n");
         goto cleanup_dungeon;
     }
 
-    // Get our number of downward stairs. Ugly cast to grab than more one byte is needed. Need to do endian conversion.
-    r = ntohs(*(uint16_t *) &buffer[p]);
-    p += sizeof(uint16_t);
+    // Get our number of downward stairs.
+    r = (int) read_value(&buffer[p], count_bytes);
+    p += count_bytes;
 
     // Check if we can read the downwards stairs without going out of bounds.
-    if (p + r * sizeof(uint8_t) > size) {
+    if (r < 0 || p + (unsigned long long) r * 2 * coordinate_bytes > size) {
         fprintf(stderr, "EOF! File is missing downwards staircase info! Using random dungeon!\n");
         goto cleanup_dungeon;
     }
@@ -344,26 +374,25 @@ Dungeon_T *load_dungeon(const char *path, bool stairs) {
     // Place our downwards staircases, failing if the coordinate aren't in range or if they aren't in open space.
     // Iterate through each staircase.
     for (i = 0; i < r; i++) {
+        x = (int) read_value(&buffer[p], coordinate_bytes);
+        y = (int) read_value(&buffer[p + coordinate_bytes], coordinate_bytes);
 
         // Check if the room stair coordinate are in range
-        if (buffer[p + 1] > DUNGEON_HEIGHT - 1 || buffer[p] > DUNGEON_WIDTH - 1) {
-            fprintf(stderr,
-                    "Out of bounds downwards stairs (%i, %i)! Using random dungeon!\n",
-                    buffer[p], buffer[p + 1]);
+        if (y > d->height - 1 || x > d->width - 1) {
+            fprintf(stderr, "Out of bounds downwards stairs (%i, %i)! Using random dungeon!\n", x, y);
             goto cleanup_dungeon;
         }
 
         // Check if the stairs are in open space.
-        if (d->MAP(buffer[p + 1], buffer[p]).hardness != 0) {
-            fprintf(stderr, "Downwards staircases cannot be in rock (%i, %i)! Using random dungeon!\n",
-                    buffer[p], buffer[p + 1]);
+        if (d->HARDNESS(y, x) != 0) {
+            fprintf(stderr, "Downwards staircases cannot be in rock (%i, %i)! Using random dungeon!\n", x, y);
             goto cleanup_dungeon;
         }
 
         // Add the stair to the dungeon
-        d->MAP(buffer[p + 1], buffer[p]).type = STAIR_DOWN;
+        d->TYPE(y, x) = STAIR_DOWN;
         placed_stairs = true;
-        p += 2 * sizeof(uint8_t);
+        p += 2 * coordinate_bytes;
     }
 
     // If the dungeon from the file has no stairs, and the user passed the stairs option, make sure we add some.
@@ -389,7 +418,7 @@ Dungeon_T *load_dungeon(const char *path, bool stairs) {
     free(buffer);
 
     cleanup:
-    return generate_dungeon(DUNGEON_HEIGHT, DUNGEON_WIDTH, MIN_NUM_ROOMS, MAX_NUM_ROOMS, PERCENTAGE_ROOM_COVERED);
+    return generate_default_dungeon(height, width, seed, NULL);
 }
 
 // Load a dungeon from a pgm file, allowing the user to create their own dungeons in a photo editor. It's picky, but
@@ -399,9 +428,9 @@ Dungeon_T *load_dungeon(const char *path, bool stairs) {
 //
 // A limitation of these pgm maps is that all rooms will be 1x1. Shouldn't be the end of the world, but might be
 // significant later as the project progresses. Just adds memory overhead.
-Dungeon_T *load_pgm(const char *path, bool stairs) {
+Dungeon_T *load_pgm(const char *path, bool stairs, int height, int width, uint64_t seed) {
     FILE *f;
-    int height, width, max_val, i, j, r;
+    int pgm_height, pgm_width, max_val, i, j, r;
     char *read, *end;
     unsigned char *buffer;
     unsigned long long size, p, p2;
@@ -421,8 +450,9 @@ Dungeon_T *load_pgm(const char *path, bool stairs) {
 
     // Check if the file is bigger than the max. Bail out if it is. It's not going to be a valid file then.
     if (size > MAX_PGM_FILE_SIZE) {
-        fprintf(stderr, "File is %llu bytes, bigger than maximum size of %i bytes! Using random dungeon!\n",
+        fprintf(stderr, "File is %llu bytes, bigger than maximum size of %llu bytes! Using random dungeon!\n",
                 size, MAX_PGM_FILE_SIZE);
+        fclose(f);
         goto cleanup;
     }
 
@@ -487,8 +517,8 @@ Dungeon_T *load_pgm(const char *path, bool stairs) {
     // Read in width
     read = safe_calloc(p2 - p, sizeof(char));
     strncpy(read, (char *) &buffer[p], (p2 - 1) - p);
-    width = (int) strtol(read, &end, 0);
-    if (width == 0 || end == NULL || *end != (char) 0) {
+    pgm_width = (int) strtol(read, &end, 0);
+    if (pgm_width == 0 || end == NULL || *end != (char) 0) {
         fprintf(stderr, "Malformed width! %s is invalid! Using random dungeon!\n", read);
         goto cleanup_buffer;
     }
@@ -514,8 +544,8 @@ Dungeon_T *load_pgm(const char *path, bool stairs) {
     // Read in height
     read = safe_calloc(p2 - p, sizeof(char));
     strncpy(read, (char *) &buffer[p], (p2 - 1) - p);
-    height = (int) strtol(read, &end, 0);
-    if (height == 0 || end == NULL || *end != (char) 0) {
+    pgm_height = (int) strtol(read, &end, 0);
+    if (pgm_height == 0 || end == NULL || *end != (char) 0) {
         fprintf(stderr, "Malformed height! %s is invalid! Using random dungeon!\n", read);
         goto cleanup_buffer;
     }
@@ -548,29 +578,38 @@ Dungeon_T *load_pgm(const char *path, bool stairs) {
     free(read);
     p = p2;
 
+    // Check if the dungeon, once it has a border around it, is a size we can play
+    if (pgm_height + 2 < MIN_DUNGEON_HEIGHT || pgm_height + 2 > MAX_DUNGEON_HEIGHT ||
+        pgm_width + 2 < MIN_DUNGEON_WIDTH || pgm_width + 2 > MAX_DUNGEON_WIDTH) {
+        fprintf(stderr, "Invalid PGM size %ix%i! Must be between %ix%i and %ix%i! Using random dungeon!\n",
+                pgm_width, pgm_height, MIN_DUNGEON_WIDTH - 2, MIN_DUNGEON_HEIGHT - 2, MAX_DUNGEON_WIDTH - 2,
+                MAX_DUNGEON_HEIGHT - 2);
+        goto cleanup_buffer;
+    }
+
     // Check if we have space to read in the full array
-    if (p + width * height * sizeof(uint8_t) > size) {
+    if (p + (unsigned long long) pgm_width * pgm_height * sizeof(uint8_t) > size) {
         fprintf(stderr, "EOF! File is missing array data! Using random dungeon!\n");
         goto cleanup_buffer;
     }
 
     // Allocate space for our dungeon
     d = safe_malloc(sizeof(Dungeon_T));
-    init_dungeon(d, height + 2, width + 2);
+    init_dungeon(d, pgm_height + 2, pgm_width + 2, seed);
 
     // Read in the pgm array
     for (i = 1; i < d->height - 1; i++) {
         for (j = 1; j < d->width - 1; j++) {
             if (buffer[p] == PGM_CORRIDOR_VAL) {
-                d->MAP(i, j).type = CORRIDOR;
-                d->MAP(i, j).hardness = 0;
+                d->TYPE(i, j) = CORRIDOR;
+                d->HARDNESS(i, j) = 0;
             } else if (buffer[p] == PGM_ROOM_VAL) {
-                d->MAP(i, j).type = ROOM;
-                d->MAP(i, j).hardness = 0;
+                d->TYPE(i, j) = ROOM;
+                d->HARDNESS(i, j) = 0;
                 d->num_rooms++;
             } else {
-                d->MAP(i, j).type = ROCK;
-                d->MAP(i, j).hardness = buffer[p];
+                d->TYPE(i, j) = ROCK;
+                d->HARDNESS(i, j) = buffer[p];
             }
             p += sizeof(uint8_t);
         }
@@ -591,11 +630,12 @@ Dungeon_T *load_pgm(const char *path, bool stairs) {
 
     for (i = 1; i < d->height - 1; i++) {
         for (j = 1; j < d->width - 1; j++) {
-            if (d->MAP(i, j).type == ROOM) {
+            if (d->TYPE(i, j) == ROOM) {
                 d->rooms[r].y = i;
                 d->rooms[r].x = j;
                 d->rooms[r].height = 1;
                 d->rooms[r].width = 1;
+                mark_dungeon_room(d, r);
                 r++;
             }
         }
@@ -618,22 +658,23 @@ Dungeon_T *load_pgm(const char *path, bool stairs) {
     free(buffer);
 
     cleanup:
-    return generate_dungeon(DUNGEON_HEIGHT, DUNGEON_WIDTH, MIN_NUM_ROOMS, MAX_NUM_ROOMS, PERCENTAGE_ROOM_COVERED);
+    return generate_default_dungeon(height, width, seed, NULL);
 }
 
 // Massive function that saves the dungeon to disk. Works basically the opposite of the load_dungeon() function. It
 // allocates a byte array the size of the file, fills the byte array, and writes it in one fell swoop for efficiency
 // purposes. It keeps an iterator int, always updating so we write to the correct part of the byte array. Makes sure
-// to always write in big-endian, as per spec.
+// to always write in big-endian, as per spec. Dungeons the default size are written in the original version, and
+// anything else in the sized version.
 //
 // Makes a bunch of explicit casts for the purposes of safety... and to keep my IDE happy.
 void save_dungeon(Dungeon_T *d, const char *path) {
     FILE *f;
-    int i, j, p, p2;
+    int i, j, coordinate_bytes, count_bytes;
     unsigned char *buffer;
     char *marker;
-    uint32_t size, version;
-    uint16_t num_rooms, up, down;
+    uint32_t size, version, up, down;
+    size_t p, p2;
 
     // Try to open the file... don't need to do the other work if it doesn't open
     f = fopen(path, "wb");
@@ -646,23 +687,34 @@ void save_dungeon(Dungeon_T *d, const char *path) {
     up = down = 0;
     for (i = 0; i < d->height; i++) {
         for (j = 0; j < d->width; j++) {
-            if (d->MAP(i, j).type == STAIR_UP) {
+            if (d->TYPE(i, j) == STAIR_UP) {
                 up++;
                 continue;
             }
-            if (d->MAP(i, j).type == STAIR_DOWN) {
+            if (d->TYPE(i, j) == STAIR_DOWN) {
                 down++;
                 continue;
             }
         }
     }
 
+    // Pick the version. The original only fits the default size, and needs its counts to fit in 16 bits.
+    if (d->height == DUNGEON_HEIGHT && d->width == DUNGEON_WIDTH) {
+        version = FILE_VERSION;
+        coordinate_bytes = sizeof(uint8_t);
+        count_bytes = sizeof(uint16_t);
+    } else {
+        version = SIZED_FILE_VERSION;
+        coordinate_bytes = sizeof(uint16_t);
+        count_bytes = sizeof(uint32_t);
+    }
+
     // Set up values for memcpy() later. Necessary because we can't just set the memory to directly be the macro
     // values.
     marker = FILE_MARKER;
-    version = htonl(FILE_VERSION);
-    size = sizeof(FILE_MARKER) - 1 + sizeof(uint32_t) * 2 + sizeof(uint16_t) * 3 +
-           (2 + d->height * d->width + d->num_rooms * 4 + up * 2 + down * 2) * sizeof(uint8_t);
+    size = sizeof(FILE_MARKER) - 1 + sizeof(uint32_t) * 2 + (version == SIZED_FILE_VERSION) * sizeof(uint16_t) * 2 +
+           count_bytes * 3 + d->height * d->width * sizeof(uint8_t) +
+           (2 + d->num_rooms * 4 + up * 2 + down * 2) * coordinate_bytes;
 
     // Allocate our entire array so we can write at once
     buffer = safe_malloc(size);
@@ -672,71 +724,67 @@ void save_dungeon(Dungeon_T *d, const char *path) {
 
     // Insert file marker
     memcpy(&buffer[p], marker, strlen(marker)); // NOLINT(bugprone-not-null-terminated-result)
-    p += (int) strlen(marker);
+    p += strlen(marker);
 
     // Insert version number
-    memcpy(&buffer[p], &version, sizeof(uint32_t));
+    write_value(&buffer[p], version, sizeof(uint32_t));
     p += sizeof(uint32_t);
 
     // Insert file size
-    size = htonl(size);
-    memcpy(&buffer[p], &size, sizeof(uint32_t));
+    write_value(&buffer[p], size, sizeof(uint32_t));
     p += sizeof(uint32_t);
-    size = ntohl(size);
+
+    // Insert the dimensions, if the version has them
+    if (version == SIZED_FILE_VERSION) {
+        write_value(&buffer[p], (uint32_t) d->height, sizeof(uint16_t));
+        write_value(&buffer[p + sizeof(uint16_t)], (uint32_t) d->width, sizeof(uint16_t));
+        p += sizeof(uint16_t) * 2;
+    }
 
     // Insert the player coordinates
-    buffer[p] = (unsigned char) d->player->x;
-    p += sizeof(uint8_t);
-    buffer[p] = (unsigned char) d->player->y;
-    p += sizeof(uint8_t);
+    write_value(&buffer[p], (uint32_t) d->player->x, coordinate_bytes);
+    write_value(&buffer[p + coordinate_bytes], (uint32_t) d->player->y, coordinate_bytes);
+    p += coordinate_bytes * 2;
 
-    // Insert the hardness map
-    for (i = 0; i < d->height; i++) {
-        for (j = 0; j < d->width; j++) {
-            buffer[p] = (unsigned char) d->MAP(i, j).hardness;
-            p += sizeof(uint8_t);
-        }
-    }
+    // Insert the hardness map. The file lays it out the same way the hardness plane is, so it copies straight over.
+    memcpy(&buffer[p], d->hardness, (size_t) d->height * d->width);
+    p += (size_t) d->height * d->width;
 
     // Insert the number of rooms
-    num_rooms = htons((uint16_t) d->num_rooms);
-    memcpy(&buffer[p], &num_rooms, sizeof(uint16_t));
-    p += sizeof(uint16_t);
+    write_value(&buffer[p], (uint32_t) d->num_rooms, count_bytes);
+    p += count_bytes;
 
     // Insert the room values
     for (i = 0; i < d->num_rooms; i++) {
-        buffer[p] = (unsigned char) d->rooms[i].x;
-        buffer[p + 1] = (unsigned char) d->rooms[i].y;
-        buffer[p + 2] = (unsigned char) d->rooms[i].width;
-        buffer[p + 3] = (unsigned char) d->rooms[i].height;
-        p += 4 * sizeof(uint8_t);
+        write_value(&buffer[p], (uint32_t) d->rooms[i].x, coordinate_bytes);
+        write_value(&buffer[p + coordinate_bytes], (uint32_t) d->rooms[i].y, coordinate_bytes);
+        write_value(&buffer[p + coordinate_bytes * 2], (uint32_t) d->rooms[i].width, coordinate_bytes);
+        write_value(&buffer[p + coordinate_bytes * 3], (uint32_t) d->rooms[i].height, coordinate_bytes);
+        p += 4 * coordinate_bytes;
     }
 
     // Insert number of upward stair cases
-    up = htons(up);
-    memcpy(&buffer[p], &up, sizeof(uint16_t));
-    p += sizeof(uint16_t);
-    up = ntohs(up);
+    write_value(&buffer[p], up, count_bytes);
+    p += count_bytes;
 
     // Insert number of downward stair cases
-    down = htons(down);
-    p2 = p + (int) (up * 2 * sizeof(uint8_t));
-    memcpy(&buffer[p2], &down, sizeof(uint16_t));
-    p2 += sizeof(uint16_t);
+    p2 = p + up * 2 * coordinate_bytes;
+    write_value(&buffer[p2], down, count_bytes);
+    p2 += count_bytes;
 
     // Insert the both stairs at once... inefficient since we don't stair stairs globally.
     for (i = 0; i < d->height; i++) {
         for (j = 0; j < d->width; j++) {
-            if (d->MAP(i, j).type == STAIR_UP) {
-                buffer[p] = (unsigned char) j;
-                buffer[p + 1] = (unsigned char) i;
-                p += 2 * sizeof(uint8_t);
+            if (d->TYPE(i, j) == STAIR_UP) {
+                write_value(&buffer[p], (uint32_t) j, coordinate_bytes);
+                write_value(&buffer[p + coordinate_bytes], (uint32_t) i, coordinate_bytes);
+                p += 2 * coordinate_bytes;
                 continue;
             }
-            if (d->MAP(i, j).type == STAIR_DOWN) {
-                buffer[p2] = (unsigned char) j;
-                buffer[p2 + 1] = (unsigned char) i;
-                p2 += 2 * sizeof(uint8_t);
+            if (d->TYPE(i, j) == STAIR_DOWN) {
+                write_value(&buffer[p2], (uint32_t) j, coordinate_bytes);
+                write_value(&buffer[p2 + coordinate_bytes], (uint32_t) i, coordinate_bytes);
+                p2 += 2 * coordinate_bytes;
                 continue;
             }
         }
@@ -773,7 +821,7 @@ void save_pgm(Dungeon_T *d, const char *path) {
            count_digits(d->height - 2) + 1 + count_digits(PGM_MAX_VAL) + 2;
     header = safe_calloc(size, sizeof(char));
     sprintf(header, "%s\n%s\n%i %i\n%i\n",
-            PGM_MAGIC_NUMBER, PGM_COMMENT, DUNGEON_WIDTH - 2, DUNGEON_HEIGHT - 2, PGM_MAX_VAL);
+            PGM_MAGIC_NUMBER, PGM_COMMENT, d->width - 2, d->height - 2, PGM_MAX_VAL);
 
     // Set up our entire array so we can write at once
     size += (d->width - 2) * (d->height - 2) * sizeof(uint8_t) - 1;
@@ -791,12 +839,12 @@ void save_pgm(Dungeon_T *d, const char *path) {
     // Write the hardness values to the array
     for (i = 1; i < d->height - 1; i++) {
         for (j = 1; j < d->width - 1; j++) {
-            if (d->MAP(i, j).type == ROOM) {
+            if (d->TYPE(i, j) == ROOM) {
                 buffer[p] = PGM_ROOM_VAL;
-            } else if (d->MAP(i, j).type == CORRIDOR) {
+            } else if (d->TYPE(i, j) == CORRIDOR) {
                 buffer[p] = PGM_CORRIDOR_VAL;
             } else {
-                buffer[p] = (unsigned char) d->MAP(i, j).hardness;
+                buffer[p] = (unsigned char) d->HARDNESS(i, j);
             }
             p += sizeof(uint8_t);
         }
@@ -2,17 +2,20 @@
 #define ROGUE_DUNGEON_DISK_H
 
 #include <stdbool.h>
+#include <stdint.h>
 
 // See dungeon-disk.c for helper functions
 
 // Forward declare so we don't have to include the dungeon header
 typedef struct Dungeon_S Dungeon_T;
 
-// Loads a dungeon from disk, returning a pointer to the dungeon. If it fails, it will fall back to a random one.
-Dungeon_T *load_dungeon(const char *path, bool stairs);
+// Loads a dungeon from disk, returning a pointer to the dungeon. The file decides how big it is. If it fails, it will
+// fall back to a random one that's height x width. The dungeon's random generator is seeded with seed.
+Dungeon_T *load_dungeon(const char *path, bool stairs, int height, int width, uint64_t seed);
 
-// Load a PGM file from disk, creating a new dungeon. If it fails, it will fall back to a random one.
-Dungeon_T *load_pgm(const char *path, bool stairs);
+// Load a PGM file from disk, creating a new dungeon the size of the image plus a border. If it fails, it will fall back
+// to a random one that's height x width. The dungeon's random generator is seeded with seed.
+Dungeon_T *load_pgm(const char *path, bool stairs, int height, int width, uint64_t seed);
 
 // Store a dungeon on disk. Will print an error to stderr if it fails
 void save_dungeon(Dungeon_T *d, const char *path);
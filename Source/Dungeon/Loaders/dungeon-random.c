@@ -1,33 +1,217 @@
+// We have to include this macro so gcc shuts up and will actually compile
+// I think this is what I get for wanting to compile against C11
+#define _POSIX_C_SOURCE 200809L // NOLINT(bugprone-reserved-identifier)
+
+#include <math.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
 
 #include "dungeon-random.h"
 
 #include "Dungeon/dijkstra.h"
 #include "Dungeon/dungeon.h"
 #include "Helpers/helpers.h"
-#include "Helpers/stack.h"
+#include "Helpers/pacer.h"
+#include "Helpers/random.h"
 #include "Settings/dungeon-settings.h"
 #include <Settings/exit-codes.h>
 
-// Private struct to store partitions. Same as rooms (for now), but separating them makes it easier to extend Room_T
-// in the future, and keeps code more readable.
-typedef struct Partition_ {
-    int y, x, height, width;
-} Partition_T;
-
-// Returns a new partition. Disparate "initializer" functions are preferred but they can cause overhead
-// in cases where heap space is already allocated to them. In this case, partitions are being put on a stack so a pointer
-// works great
-static Partition_T *new_partition(int y, int x, int height, int width) {
+// Helper that adds a partition onto the end of the dungeon's partition array, returning its index. The array is sized
+// up front by generate_dungeon(), so this never allocates.
+static int add_partition(Dungeon_T *d, int y, int x, int height, int width) {
     Partition_T *p;
-    p = safe_malloc(sizeof(Partition_T));
+
+    p = &d->partitions[d->num_partitions];
     p->y = y;
     p->x = x;
     p->height = height;
     p->width = width;
-    return p;
+    p->left = p->right = p->room = -1;
+
+    return d->num_partitions++;
+}
+
+// Helper that checks if a partition is small enough in both directions to get a room, instead of being split again
+static bool is_leaf_partition(const Partition_T *p) {
+    return MIN_PARTITION_HEIGHT <= p->height && p->height <= MAX_PARTITION_HEIGHT &&
+           MIN_PARTITION_WIDTH <= p->width && p->width <= MAX_PARTITION_WIDTH;
+}
+
+// Helper that splits a partition in two, adding both halves to the dungeon's partition array. If the dimensions of the
+// partition are outside of PERCENTAGE_SPLIT_FORCE of each other, or one of the sides is in range for the allowed sizes
+// for partitions it will split along the long side... otherwise it will randomly choose a direction to split along. It
+// splits along a valid range, making sure both resultant partitions will be valid according to the minimums in
+// setting.h.
+static void split_partition(Dungeon_T *d, int p) {
+    int split, left, right;
+    bool split_horizontal;
+
+    // Ugly ternary... checks if the dimension is within valid range, since we don't want to split that direction
+    // then. If it's not, we split on if height or width is within PERCENTAGE_SPLIT_FORCE of each other. If all of
+    // these are false, we pick a random direction. Cast to bool for safety... even though it will always be 0 or 1.
+    split_horizontal = (bool)
+            (MIN_PARTITION_HEIGHT <= d->partitions[p].height && d->partitions[p].height <= MAX_PARTITION_HEIGHT ?
+             false : // height range
+             MIN_PARTITION_WIDTH <= d->partitions[p].width && d->partitions[p].width <= MAX_PARTITION_WIDTH ?
+             true : // width range
+             d->partitions[p].height * (1 + PERCENTAGE_SPLIT_FORCE) < (float) d->partitions[p].width ?
+             false : // height is much smaller
+             d->partitions[p].width * (1 + PERCENTAGE_SPLIT_FORCE) < (float) d->partitions[p].height ?
+             true : // width is much smaller
+             random_bool(&d->random));
+
+    // Do the split
+    if (split_horizontal) {
+        split = random_int_in_range(&d->random, MIN_PARTITION_HEIGHT, d->partitions[p].height - MIN_PARTITION_HEIGHT);
+        left = add_partition(d, d->partitions[p].y, d->partitions[p].x, split, d->partitions[p].width);
+        right = add_partition(d, d->partitions[p].y + split, d->partitions[p].x, d->partitions[p].height - split,
+                              d->partitions[p].width);
+    } else {
+        split = random_int_in_range(&d->random, MIN_PARTITION_WIDTH, d->partitions[p].width - MIN_PARTITION_WIDTH);
+        left = add_partition(d, d->partitions[p].y, d->partitions[p].x, d->partitions[p].height, split);
+        right = add_partition(d, d->partitions[p].y, d->partitions[p].x + split, d->partitions[p].height,
+                              d->partitions[p].width - split);
+    }
+    d->partitions[p].left = left;
+    d->partitions[p].right = right;
+}
+
+#if CONSTRUCTIVE_ROOM_PLACEMENT == true
+
+// Helper that splits the whole dungeon up into leaf partitions, without putting any rooms in them yet. Partitions are
+// split in the same order generate_rooms() would, using the stack sized by generate_dungeon().
+static void partition_dungeon(Dungeon_T *d, int *stack) {
+    int top;
+
+    // Start the tree over, and seed the stack with a partition covering everything inside the border
+    d->num_partitions = 0;
+    top = 0;
+    stack[top++] = add_partition(d, 1, 1, d->height - 2, d->width - 2);
+
+    // Split everything that's too big to be a leaf
+    while (top > 0) {
+        int p;
+
+        p = stack[--top];
+        split_partition(d, p);
+        if (!is_leaf_partition(&d->partitions[d->partitions[p].left])) {
+            stack[top++] = d->partitions[p].left;
+        }
+        if (!is_leaf_partition(&d->partitions[d->partitions[p].right])) {
+            stack[top++] = d->partitions[p].right;
+        }
+    }
 }
 
+// Helper that puts a room in a leaf partition, picking its corner and then its size straight out of the ones that fit,
+// so there's nothing to check afterwards. The room never uses the last row or column of its partition, which leaves at
+// least one cell of rock between it and the room in any partition below or to the right of it... so no two rooms can
+// ever touch. min_height and min_width are how small the room is allowed to be.
+static void place_room(Dungeon_T *d, int p, int min_height, int min_width) {
+    Partition_T *part;
+    Room_T *r;
+    int i, j;
+
+    part = &d->partitions[p];
+    r = &d->rooms[d->num_rooms];
+    r->y = random_int_in_range(&d->random, part->y, part->y + part->height - 1 - min_height);
+    r->x = random_int_in_range(&d->random, part->x, part->x + part->width - 1 - min_width);
+    r->height = random_int_in_range(&d->random, min_height, part->y + part->height - 1 - r->y);
+    r->width = random_int_in_range(&d->random, min_width, part->x + part->width - 1 - r->x);
+    part->room = d->num_rooms;
+    d->num_rooms++;
+    mark_dungeon_room(d, part->room);
+
+    // Paint the room into the dungeon
+    for (i = r->y; i < r->y + r->height; i++) {
+        for (j = r->x; j < r->x + r->width; j++) {
+            d->TYPE(i, j) = ROOM;
+            d->HARDNESS(i, j) = OPEN_SPACE_HARDNESS;
+        }
+    }
+}
+
+// Generates the rooms in one pass, with nothing to retry, once partition_dungeon() has split up the dungeon. Every leaf
+// gets a room, unless there are more leaves than max_rooms, in which case a random max_rooms of them do. Coverage is
+// handled by working out how much of the leaves' space the rooms need to take up, and making every room at least that
+// much of its leaf in both directions, so the rooms add up to enough no matter what gets picked. Bails out if min_rooms
+// or percentage_covered can't be met at all by this partitioning.
+static void generate_rooms_constructively(Dungeon_T *d, int *stack, int min_rooms, int max_rooms,
+                                          float percentage_covered) {
+    long long needed, space;
+    double scale;
+    int num_leaves, i;
+
+    // Reuse the stack partition_dungeon() is done with to hold the leaves
+    num_leaves = 0;
+    for (i = 0; i < d->num_partitions; i++) {
+        if (d->partitions[i].left == -1) {
+            stack[num_leaves++] = i;
+        }
+    }
+
+    // Every leaf is at most the maximum partition size, so the default room counts always leave enough leaves. Only
+    // a minimum set higher than that can fall short.
+    if (num_leaves < min_rooms) {
+        bail(DUNGEON_GENERATION_FAILURE,
+             "FATAL ERROR! ONLY %i PARTITIONS FIT FOR AT LEAST %i ROOMS! TRY NEW PARAMETERS!\n", num_leaves, min_rooms);
+    }
+
+    // Pick which leaves get rooms if there are too many, by shuffling a random max_rooms of them to the front
+    if (num_leaves > max_rooms) {
+        for (i = 0; i < max_rooms; i++) {
+            int swap, temp;
+
+            swap = random_int_in_range(&d->random, i, num_leaves - 1);
+            temp = stack[i];
+            stack[i] = stack[swap];
+            stack[swap] = temp;
+        }
+        num_leaves = max_rooms;
+    }
+
+    // Work out how much room cells have to be strictly more than percentage_covered of the map, and how much the
+    // biggest rooms the picked leaves could hold would cover
+    needed = (long long) (percentage_covered * d->height * d->width) + 1;
+    space = 0;
+    for (i = 0; i < num_leaves; i++) {
+        space += (long long) (d->partitions[stack[i]].height - 1) * (d->partitions[stack[i]].width - 1);
+    }
+    if (needed > space) {
+        bail(DUNGEON_GENERATION_FAILURE,
+             "FATAL ERROR! ROOMS CAN'T COVER %.1f%% OF THE DUNGEON! TRY NEW PARAMETERS!\n", percentage_covered * 100);
+    }
+
+    // If every room is at least scale of its leaf's space in both directions, it covers at least scale squared of it,
+    // and all of them together cover at least needed. The tiny bit extra keeps rounding from coming up a cell short.
+    scale = sqrt((double) needed / (double) space) + 1e-9;
+    for (i = 0; i < num_leaves; i++) {
+        const Partition_T *p;
+        int min_height, min_width;
+
+        p = &d->partitions[stack[i]];
+        min_height = (int) ceil(scale * (p->height - 1));
+        min_width = (int) ceil(scale * (p->width - 1));
+
+        // Never below the smallest room, and never more than the leaf can hold
+        if (min_height < MIN_ROOM_HEIGHT) {
+            min_height = MIN_ROOM_HEIGHT;
+        } else if (min_height > p->height - 1) {
+            min_height = p->height - 1;
+        }
+        if (min_width < MIN_ROOM_WIDTH) {
+            min_width = MIN_ROOM_WIDTH;
+        } else if (min_width > p->width - 1) {
+            min_width = p->width - 1;
+        }
+
+        place_room(d, stack[i], min_height, min_width);
+    }
+}
+
+#else
+
 // Determines if room parameters are valid in the given dungeon. Since rooms are contained in a partition, only the
 // exterior walls need to be checked if they are within one tile of any other room.
 static bool is_valid_room(const Dungeon_T *d, int y, int x, int height, int width) {
@@ -35,14 +219,14 @@ static bool is_valid_room(const Dungeon_T *d, int y, int x, int height, int widt
 
     // Check left and right
     for (i = y - 1; i < y + height + 1; i++) {
-        if (d->MAP(i, x - 1).type != ROCK || d->MAP(i, x + width).type != ROCK) {
+        if (d->TYPE(i, x - 1) != ROCK || d->TYPE(i, x + width) != ROCK) {
             return false;
         }
     }
 
     // Check top and bottom
     for (i = x; i < x + width; i++) {
-        if (d->MAP(y - 1, i).type != ROCK || d->MAP(y + height, i).type != ROCK) {
+        if (d->TYPE(y - 1, i) != ROCK || d->TYPE(y + height, i) != ROCK) {
             return false;
         }
     }
@@ -52,8 +236,9 @@ static bool is_valid_room(const Dungeon_T *d, int y, int x, int height, int widt
 
 // Helper function that tries to fill a partition from the generate_rooms() function... if it can't fill a partition
 // after FAILED_ROOM_PLACEMENT tries, it will return false, which will trigger generate_rooms() to return false, and
-// trigger a dungeon generation failure and start the generation from scratch.
-static bool fill_partition(Dungeon_T *d, const Partition_T *p) {
+// trigger a dungeon generation failure and start the generation from scratch. Every guess that didn't fit is counted in
+// stats.
+static bool fill_partition(Dungeon_T *d, const Partition_T *p, Generation_Stats_T *stats) {
     int tries, y, x, height, width, i, j;
 
     tries = 0;
@@ -63,18 +248,20 @@ static bool fill_partition(Dungeon_T *d, const Partition_T *p) {
 
         // If we can't generate a room, cleanup and bail out.
         if (tries > FAILED_ROOM_PLACEMENT) {
+            stats->rejected_rooms += tries;
             return false;
         }
 
         // Try to generate room parameters in range.
-        y = rand_int_in_range(p->y, p->y + p->height - MIN_ROOM_HEIGHT);
-        x = rand_int_in_range(p->x, p->x + p->height - MIN_ROOM_WIDTH);
-        height = rand_int_in_range(MIN_ROOM_HEIGHT, p->y + p->height - y);
-        width = rand_int_in_range(MIN_ROOM_WIDTH, p->x + p->height - x);
+        y = random_int_in_range(&d->random, p->y, p->y + p->height - MIN_ROOM_HEIGHT);
+        x = random_int_in_range(&d->random, p->x, p->x + p->height - MIN_ROOM_WIDTH);
+        height = random_int_in_range(&d->random, MIN_ROOM_HEIGHT, p->y + p->height - y);
+        width = random_int_in_range(&d->random, MIN_ROOM_WIDTH, p->x + p->height - x);
 
         tries++;
 
     } while (!is_valid_room(d, y, x, height, width));
+    stats->rejected_rooms += tries - 1;
 
     // Add the room to the dungeon.
     d->num_rooms++;
@@ -82,103 +269,95 @@ static bool fill_partition(Dungeon_T *d, const Partition_T *p) {
     d->rooms[d->num_rooms - 1].x = x;
     d->rooms[d->num_rooms - 1].height = height;
     d->rooms[d->num_rooms - 1].width = width;
+    mark_dungeon_room(d, d->num_rooms - 1);
 
     // Paint the room into the dungeon
     for (i = y; i < y + height; i++) {
         for (j = x; j < x + width; j++) {
-            d->MAP(i, j).type = ROOM;
-            d->MAP(i, j).hardness = OPEN_SPACE_HARDNESS;
+            d->TYPE(i, j) = ROOM;
+            d->HARDNESS(i, j) = OPEN_SPACE_HARDNESS;
         }
     }
 
     return true;
 }
 
-// Heavy lifting function that fills that generate rooms in the dungeon. It does so using a binary space partition
-// It starts by partitioning the dungeon. If the dimensions of a given partition are outside of
-// PERCENTAGE_SPLIT_FORCE of each other, or one of the sides is in range for the allowed sizes for partitions
-// it will split along the long side... otherwise it will randomly choose a direction to split along. It splits along
-// a valid range, making sure both resultant partitions will be valid according to the minimums in setting.h. It then
-// adds the child partitions to the stack if they need to be split more; otherwise it fills the partition with a room,
-// bailing out if it can't fill one, and cleans up the partition. Returns true only if it was able to fill the dungeon
-// successfully.
-static bool generate_rooms(Dungeon_T *d, int max_rooms) {
-    struct Stack_S *s;
-    Partition_T *p;
+// Helper that fills a leaf partition with a room, and records which room went in it. Returns false if the dungeon
+// already has max_rooms, or the partition couldn't be filled, counting why in stats.
+static bool fill_leaf_partition(Dungeon_T *d, int p, int max_rooms, Generation_Stats_T *stats) {
+    if (d->num_rooms >= max_rooms) {
+        stats->failures[TOO_MANY_ROOMS_FAILURE]++;
+        return false;
+    }
+    if (!fill_partition(d, &d->partitions[p], stats)) {
+        stats->failures[FILL_FAILURE]++;
+        return false;
+    }
 
-    // Initialize our stack, and seed it with a partition
-    s = new_stack();
-    p = new_partition(1, 1, d->height - 2, d->width - 2);
-    stack_push(s, p);
+    d->partitions[p].room = d->num_rooms - 1;
+    return true;
+}
+
+// Heavy lifting function that fills that generate rooms in the dungeon. It does so using a binary space partition
+// It starts by partitioning the dungeon with split_partition(). It then adds the child partitions to the stack if they
+// need to be split more; otherwise it fills the partition with a room, bailing out if it can't fill one. Returns true
+// only if it was able to fill the dungeon successfully.
+//
+// Every partition is added to d->partitions as it's made, with the index of its halves, so the whole tree is there
+// afterwards. The stack only holds indexes into that array, and both were sized by generate_dungeon(), so nothing here
+// allocates.
+static bool generate_rooms(Dungeon_T *d, int *stack, int max_rooms, Generation_Stats_T *stats) {
+    int top;
+
+    // Start the tree over, and seed the stack with a partition covering everything inside the border
+    d->num_partitions = 0;
+    top = 0;
+    stack[top++] = add_partition(d, 1, 1, d->height - 2, d->width - 2);
 
     // Loop through the entire stack
-    while (s->top != -1) {
-        int split;
-        bool split_horizontal;
-        Partition_T *left, *right;
-
-        // Pop off the stack
-        p = stack_pop(s);
-
-        // Ugly ternary... checks if the dimension is within valid range, since we don't want to split that direction
-        // then. If it's not, we split on if height or width is within PERCENTAGE_SPLIT_FORCE of each other. If all of
-        // these are false, we pick a random direction. Cast to bool for safety... even though it will always be 0 or 1.
-        split_horizontal = (bool)
-                (MIN_PARTITION_HEIGHT <= p->height && p->height <= MAX_PARTITION_HEIGHT ? false : // height range
-                 MIN_PARTITION_WIDTH <= p->width && p->width <= MAX_PARTITION_WIDTH ? true : // width range
-                 p->height * (1 + PERCENTAGE_SPLIT_FORCE) < (float) p->width ? false : // height is much smaller
-                 p->width * (1 + PERCENTAGE_SPLIT_FORCE) < (float) p->height ? true : // width is much smaller
-                 rand() % 2); // NOLINT(cert-msc50-cpp)
-
-        // Do the split
-        if (split_horizontal) {
-            split = rand_int_in_range(MIN_PARTITION_HEIGHT, p->height - MIN_PARTITION_HEIGHT);
-            left = new_partition(p->y, p->x, split, p->width);
-            right = new_partition(p->y + split, p->x, p->height - split, p->width);
-        } else {
-            split = rand_int_in_range(MIN_PARTITION_WIDTH, p->width - MIN_PARTITION_WIDTH);
-            left = new_partition(p->y, p->x, p->height, split);
-            right = new_partition(p->y, p->x + split, p->height, p->width - split);
-        }
+    while (top > 0) {
+        int p, left, right;
 
-        // Check if the children partitions are valid to be split... if they are... add them to the stack to be split.
-        // Otherwise it's a partition within range, and we can generate a room for it
-        if (!(MIN_PARTITION_HEIGHT <= left->height && left->height <= MAX_PARTITION_HEIGHT) ||
-            !(MIN_PARTITION_WIDTH <= left->width && left->width <= MAX_PARTITION_WIDTH)) {
-            stack_push(s, left);
-        } else {
-
-            // If we exceed the max number of rooms or if a partition couldn't be filled, we can bail now
-            if (d->num_rooms > max_rooms || !fill_partition(d, left)) {
-                cleanup_stack(s);
-                return false;
-            }
+        // Pop off the stack and split it
+        p = stack[--top];
+        split_partition(d, p);
+        left = d->partitions[p].left;
+        right = d->partitions[p].right;
 
-            // Cleanup the left partition... it has a room now. We don't need it.
-            free(left);
+        // Check if the children partitions are valid to be split... if they are... add them to the stack to be split.
+        // Otherwise it's a partition within range, and we can generate a room for it. If we would exceed the max
+        // number of rooms or if a partition couldn't be filled, we can bail now.
+        if (!is_leaf_partition(&d->partitions[left])) {
+            stack[top++] = left;
+        } else if (!fill_leaf_partition(d, left, max_rooms, stats)) {
+            return false;
         }
 
-        if (!(MIN_PARTITION_HEIGHT <= right->height && right->height <= MAX_PARTITION_HEIGHT) ||
-            !(MIN_PARTITION_WIDTH <= right->width && right->width <= MAX_PARTITION_WIDTH)) {
-            stack_push(s, right);
-        } else {
-
-            if (d->num_rooms > max_rooms || !fill_partition(d, right)) {
-                cleanup_stack(s);
-                return false;
-            }
-
-            free(right);
+        if (!is_leaf_partition(&d->partitions[right])) {
+            stack[top++] = right;
+        } else if (!fill_leaf_partition(d, right, max_rooms, stats)) {
+            return false;
         }
-
-        // Clean up our partition... after processing we don't need it any more.
-        free(p);
     }
 
-    // Cleanup
-    cleanup_stack(s);
     return true;
+}
 
+// Helper that throws out every room from a failed attempt, so the next one starts from solid rock again. Only has to
+// look inside the rooms, since nothing else has been painted yet.
+static void clear_rooms(Dungeon_T *d) {
+    int r, i, j;
+
+    for (r = 0; r < d->num_rooms; r++) {
+        for (i = d->rooms[r].y; i < d->rooms[r].y + d->rooms[r].height; i++) {
+            for (j = d->rooms[r].x; j < d->rooms[r].x + d->rooms[r].width; j++) {
+                d->TYPE(i, j) = DEFAULT_CELL_TYPE;
+                d->HARDNESS(i, j) = DEFAULT_HARDNESS;
+                d->ROOM_ID(i, j) = NO_ROOM;
+            }
+        }
+    }
+    d->num_rooms = 0;
 }
 
 // Helper function that iterates through the array, counts all cells that are rooms, and returns true if it is more than
@@ -189,7 +368,7 @@ static bool is_room_percentage_covered(const Dungeon_T *d, float percentage_cove
     count = 0;
     for (i = 0; i < d->height; i++) {
         for (j = 0; j < d->width; j++) {
-            if (d->MAP(i, j).type == ROOM) {
+            if (d->TYPE(i, j) == ROOM) {
                 count++;
             }
         }
@@ -198,128 +377,257 @@ static bool is_room_percentage_covered(const Dungeon_T *d, float percentage_cove
     return ((count / (double) (d->height * d->width)) > percentage_covered);
 }
 
+#endif
+
+// Helper that returns how many seconds it's been since last, and moves last up to now
+static double lap(struct timespec *last) {
+    struct timespec now;
+    double seconds;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    seconds = (double) time_difference(&now, last) / NANOSECONDS;
+    *last = now;
+
+    return seconds;
+}
+
+#if SMOOTH_HARDNESS == true
+
+// Helper that eases t from 0 to 1 with a smooth start and stop, so the noise has no creases along the grid lines
+static float smooth_step(float t) {
+    return t * t * (3 - 2 * t);
+}
+
+// Helper that returns the random value of point (y, x) on a noise grid, between 0 and 1
+static float grid_value(uint64_t key, int y, int x) {
+    return (float) (random_counter(key, (uint64_t) (uint32_t) y << 32 | (uint32_t) x) >> 40) / (float) (1 << 24);
+}
+
+// Helper that fills out with smooth hardness for the insides of row y. It's value noise: each octave is a grid of
+// random values, with the first HARDNESS_NOISE_SCALE cells apart and each after half as far apart and counting half as
+// much, blended smoothly between the grid points around every cell. Only the two grid rows around y are worked out
+// per octave, into top and bottom, so it costs a couple of hashes per grid column and a blend per cell. sum is scratch
+// space as wide as the row.
+static void fill_noise_row(uint64_t key, int y, int width, int *out, float *sum, float *top, float *bottom) {
+    float amplitude, total;
+    int octave, scale, j;
+
+    for (j = 1; j < width - 1; j++) {
+        sum[j] = 0;
+    }
+
+    amplitude = 1;
+    total = 0;
+    for (octave = 0; octave < HARDNESS_NOISE_OCTAVES; octave++) {
+        uint64_t octave_key;
+        float fy;
+        int gy;
+
+        // Every octave gets its own grid
+        octave_key = random_counter(key, (uint64_t) octave);
+        scale = HARDNESS_NOISE_SCALE >> octave > 1 ? HARDNESS_NOISE_SCALE >> octave : 1;
+        gy = y / scale;
+        fy = smooth_step((float) (y % scale) / (float) scale);
+        for (j = 0; j <= (width - 1) / scale + 1; j++) {
+            top[j] = grid_value(octave_key, gy, j);
+            bottom[j] = grid_value(octave_key, gy + 1, j);
+        }
+
+        // Blend across, then down
+        for (j = 1; j < width - 1; j++) {
+            float fx, upper, lower;
+            int gx;
+
+            gx = j / scale;
+            fx = smooth_step((float) (j % scale) / (float) scale);
+            upper = top[gx] + (top[gx + 1] - top[gx]) * fx;
+            lower = bottom[gx] + (bottom[gx + 1] - bottom[gx]) * fx;
+            sum[j] += (upper + (lower - upper) * fy) * amplitude;
+        }
+
+        total += amplitude;
+        amplitude /= 2;
+    }
+
+    // Scale the sum back down to between 0 and 1, and out to the hardness range
+    for (j = 1; j < width - 1; j++) {
+        int h;
+
+        h = MIN_ROCK_HARDNESS + (int) (sum[j] / total * (MAX_ROCK_HARDNESS - MIN_ROCK_HARDNESS + 1));
+        out[j - 1] = h > MAX_ROCK_HARDNESS ? MAX_ROCK_HARDNESS : h;
+    }
+}
+
+#endif
+
 // Randomizes the hardness across the dungeon, within the range provided in setting.h. It does not touch the exterior
-// walls at all.
+// walls at all. Only one value is drawn from the dungeon's generator, as a key, and every cell's hardness comes from
+// hashing its index under it (see random_counter()). That leaves no chain from one cell to the next, so a whole row is
+// filled in one tight loop the compiler can vectorize, and any cell's hardness could be worked out again on its own.
+// With SMOOTH_HARDNESS, the key seeds value noise instead.
 static void randomize_hardness(Dungeon_T *d) {
+    uint64_t key;
+    int *hardness;
     int i, j;
+    #if SMOOTH_HARDNESS == true
+    float *sum, *top, *bottom;
+
+    sum = safe_malloc(d->width * sizeof(float));
+    top = safe_malloc((d->width + 2) * sizeof(float));
+    bottom = safe_malloc((d->width + 2) * sizeof(float));
+    #endif
 
+    key = random_next(&d->random);
+    hardness = safe_malloc((d->width - 2) * sizeof(int));
     for (i = 1; i < d->height - 1; i++) {
+        #if SMOOTH_HARDNESS == true
+        fill_noise_row(key, i, d->width, hardness, sum, top, bottom);
+        #else
+        random_counter_fill_in_range(key, (uint64_t) i * d->width + 1, hardness, d->width - 2, MIN_ROCK_HARDNESS,
+                                     MAX_ROCK_HARDNESS);
+        #endif
         for (j = 1; j < d->width - 1; j++) {
-            if (d->MAP(i, j).type == ROCK) {
-                d->MAP(i, j).hardness += rand_int_in_range(MIN_ROCK_HARDNESS, MAX_ROCK_HARDNESS);
+            if (d->TYPE(i, j) == ROCK) {
+                d->HARDNESS(i, j) += hardness[j - 1];
             }
         }
     }
-}
-
-// Heavy lifting function that paints corridors. Given the source pair and destination pair, it will call the
-// dijkstra functions to create a new cost map from the source. It then starts at the destination and "rolls downhill".
-// By starting at the destination and always visiting the cheapest neighbor node, we can generate a shortest path.
-// There may be multiple, but it will always go in order of NORTH, SOUTH, WEST, and then EAST, if costs are equal.
-// As it builds the path, it will paint any rock tiles to be corridors and set the hardness of those to be equal to
-// the default hardness in setting.h
-static void paint_corridor(Dungeon_T *d, int src_y, int src_x, int dst_y, int dst_x) {
-
-    // Define cardinal enums to help avoid programming errors
-    typedef enum Cardinal_E {
-        UP, DOWN, LEFT, RIGHT
-    } Cardinal_T;
-
-    int sources[1][2];
-    int *cost;
-    int i, j;
-
-    // Fill the sources array to pass to the Dijkstra function.
-    sources[0][0] = src_y;
-    sources[0][1] = src_x;
+    free(hardness);
 
-    // Generate our cost map. See dijkstra.c
-    cost = generate_dijkstra_map(d, 1, (int *) sources, false, CORRIDOR_MAP);
+    #if SMOOTH_HARDNESS == true
+    free(sum);
+    free(top);
+    free(bottom);
+    #endif
+}
 
-    // Starting at the destination, roll downhill to the cheapest node
-    i = dst_y;
-    j = dst_x;
+// Private struct for a place two rooms' regions touch, and so a way the two rooms could be connected. a and b are the
+// two cells on either side (as y * width + x), and cost is what the corridor through them would cost.
+typedef struct Corridor_Edge_S {
+    int cost, a, b;
+} Corridor_Edge_T;
 
-    while (i != src_y || j != src_x) {
-        int best_cost;
-        Cardinal_T direction;
+// Helper for qsort() that orders edges cheapest first. Ties are broken by cell, so the order never depends on qsort().
+static int compare_corridor_edges(const void *a, const void *b) {
+    const Corridor_Edge_T *e1, *e2;
 
-        // Start with up
-        direction = UP;
-        best_cost = COST(i - 1, j);
+    e1 = a;
+    e2 = b;
+    if (e1->cost != e2->cost) {
+        return e1->cost < e2->cost ? -1 : 1;
+    }
+    if (e1->a != e2->a) {
+        return e1->a < e2->a ? -1 : 1;
+    }
+    return e1->b < e2->b ? -1 : e1->b > e2->b;
+}
 
-        if (best_cost > COST(i + 1, j)) {
-            best_cost = COST(i + 1, j);
-            direction = DOWN;
-        }
+// Helper that finds which set of connected rooms a room is in, flattening the path as it goes so later finds are quick
+static int find_room_set(int *sets, int r) {
+    while (sets[r] != r) {
+        sets[r] = sets[sets[r]];
+        r = sets[r];
+    }
+    return r;
+}
 
-        if (best_cost > COST(i, j - 1)) {
-            best_cost = COST(i, j - 1);
-            direction = LEFT;
-        }
+// Helper that adds an edge between two cells if they're closest to different rooms
+static void add_corridor_edge(Corridor_Edge_T **edges, int *num_edges, int *max_edges, const int *cost,
+                              const int *nearest, int a, int b) {
+    if (nearest[a] == nearest[b] || nearest[a] == -1 || nearest[b] == -1) {
+        return;
+    }
 
-        // We don't care about setting cost, since this is the last neighbor to check
-        if (best_cost > COST(i, j + 1)) {
-            direction = RIGHT;
-        }
+    // Make room as needed
+    if (*num_edges == *max_edges) {
+        *max_edges *= 2;
+        *edges = safe_realloc(*edges, *max_edges * sizeof(Corridor_Edge_T));
+    }
 
-        // Travel to the chosen cell
-        switch (direction) {  // NOLINT(hicpp-multiway-paths-covered)
-            case UP:
-                i -= 1;
-                break;
-            case DOWN:
-                i += 1;
-                break;
-            case LEFT:
-                j -= 1;
-                break;
-            case RIGHT:
-                j += 1;
-                break;
-        }
+    (*edges)[*num_edges].cost = cost[a] + cost[b];
+    (*edges)[*num_edges].a = a;
+    (*edges)[*num_edges].b = b;
+    (*num_edges)++;
+}
 
-        // Actually paint the corridor into the dungeon map
-        if (d->MAP(i, j).type == ROCK) {
-            d->MAP(i, j).type = CORRIDOR;
-            d->MAP(i, j).hardness = OPEN_SPACE_HARDNESS;
+// Helper that paints the cheapest path from a cell back to the room it's closest to, turning any rock along the way
+// into corridor and setting its hardness to the default in setting.h
+static void paint_corridor(Dungeon_T *d, const int *previous, int c) {
+    while (c != -1) {
+        if (d->types[c] == ROCK) {
+            d->types[c] = CORRIDOR;
+            d->hardness[c] = OPEN_SPACE_HARDNESS;
         }
+        c = previous[c];
     }
-    free(cost);
 }
 
-// Function that iterates through a random permutation of the rooms. Starting at the first room in the permutation
-// it will connect it to the next, and so on, until it's connected all of them. The source and destination coordinates
-// for paint_corridor() are set to be random points within the room itself for added variability.
-static void generate_corridors(Dungeon_T *d) {
-    int *shuffle;
-    int i;
+// See dungeon-random.h
+//
+// Builds a minimum spanning tree over the rooms. One Dijkstra pass from every room at
+// once (see generate_room_dijkstra_map()) splits the map into the cells closest to each room, and keeps the cheapest
+// path from every cell back to its room. Wherever two rooms' cells touch, there's a corridor between them that costs
+// the two paths added together. Kruskal's algorithm then takes the cheapest of those that join rooms that aren't
+// connected yet, until they all are, and paints each one by walking both cells back to their rooms. This is
+// Mehlhorn's approximation of the cheapest tree connecting the rooms, and it takes one pass over the map no matter how
+// many rooms there are, instead of a whole Dijkstra map for every pair.
+void generate_corridors(Dungeon_T *d) {
+    Corridor_Edge_T *edges;
+    int *cost, *nearest, *previous, *sets;
+    int num_edges, max_edges, connected, i, j;
+
+    // Find which room every cell is closest to, and how to get back to it
+    nearest = safe_malloc(d->height * d->width * sizeof(int));
+    previous = safe_malloc(d->height * d->width * sizeof(int));
+    cost = generate_room_dijkstra_map(d, nearest, previous);
+
+    // Gather every place two regions touch. Only looking south and east gets every pair of neighbors once.
+    num_edges = 0;
+    max_edges = d->num_rooms * 4;
+    edges = safe_malloc(max_edges * sizeof(Corridor_Edge_T));
+    for (i = 1; i < d->height - 1; i++) {
+        for (j = 1; j < d->width - 1; j++) {
+            if (i + 1 < d->height - 1) {
+                add_corridor_edge(&edges, &num_edges, &max_edges, cost, nearest, i * d->width + j,
+                                  (i + 1) * d->width + j);
+            }
+            if (j + 1 < d->width - 1) {
+                add_corridor_edge(&edges, &num_edges, &max_edges, cost, nearest, i * d->width + j,
+                                  i * d->width + j + 1);
+            }
+        }
+    }
+    qsort(edges, num_edges, sizeof(Corridor_Edge_T), compare_corridor_edges);
 
-    // Generate a random permutation of the rooms
-    shuffle = safe_malloc(d->num_rooms * sizeof(int));
+    // Every room starts off connected to nothing but itself
+    sets = safe_malloc(d->num_rooms * sizeof(int));
     for (i = 0; i < d->num_rooms; i++) {
-        shuffle[i] = i;
+        sets[i] = i;
     }
-    shuffle_int_array(shuffle, d->num_rooms);
-
-    // Connect the rooms one to the next. Always generate in range so we don't have to bounds check.
-    for (i = 0; i < d->num_rooms - 1; i++) {
-        int src_y, src_x, dst_y, dst_x;
 
-        // Generate pairs in each room
-        src_y = rand_int_in_range(d->rooms[shuffle[i]].y, d->rooms[shuffle[i]].y + d->rooms[shuffle[i]].height - 1);
-        src_x = rand_int_in_range(d->rooms[shuffle[i]].x, d->rooms[shuffle[i]].x + d->rooms[shuffle[i]].width - 1);
+    // Take the cheapest edges that join two groups of rooms, until there's only one group left
+    connected = 1;
+    for (i = 0; i < num_edges && connected < d->num_rooms; i++) {
+        int a, b;
 
-        dst_y = rand_int_in_range(d->rooms[shuffle[i + 1]].y,
-                                  d->rooms[shuffle[i + 1]].y + d->rooms[shuffle[i + 1]].height - 1);
-        dst_x = rand_int_in_range(d->rooms[shuffle[i + 1]].x,
-                                  d->rooms[shuffle[i + 1]].x + d->rooms[shuffle[i + 1]].width - 1);
+        a = find_room_set(sets, nearest[edges[i].a]);
+        b = find_room_set(sets, nearest[edges[i].b]);
+        if (a == b) {
+            continue;
+        }
 
-        paint_corridor(d, src_y, src_x, dst_y, dst_x);
+        sets[a] = b;
+        connected++;
+        paint_corridor(d, previous, edges[i].a);
+        paint_corridor(d, previous, edges[i].b);
     }
 
-    // Cleanup our permutation array
-    free(shuffle);
+    // Cleanup
+    free(sets);
+    free(edges);
+    free(cost);
+    free(previous);
+    free(nearest);
 }
 
 // Simply places an upward stair and a downwards stair within rooms in the dungeon, and not in the same room.
@@ -327,69 +635,144 @@ static void place_stairs(Dungeon_T *d) {
     int r1, r2, y, x;
 
     // Pick a room, then pick coordinates in that room, and paint
-    r1 = rand_int_in_range(0, d->num_rooms - 1);
-    y = rand_int_in_range(d->rooms[r1].y + 1, d->rooms[r1].y + d->rooms[r1].height - 2);
-    x = rand_int_in_range(d->rooms[r1].x + 1, d->rooms[r1].x + d->rooms[r1].width - 2);
-    d->MAP(y, x).type = STAIR_UP;
+    r1 = random_int_in_range(&d->random, 0, d->num_rooms - 1);
+    y = random_int_in_range(&d->random, d->rooms[r1].y + 1, d->rooms[r1].y + d->rooms[r1].height - 2);
+    x = random_int_in_range(&d->random, d->rooms[r1].x + 1, d->rooms[r1].x + d->rooms[r1].width - 2);
+    d->TYPE(y, x) = STAIR_UP;
 
     // Pick a different room, then pick coordinates in the new room and paint
     do {
-        r2 = rand_int_in_range(0, d->num_rooms - 1);
+        r2 = random_int_in_range(&d->random, 0, d->num_rooms - 1);
     } while (r1 == r2);
-    y = rand_int_in_range(d->rooms[r2].y + 1, d->rooms[r2].y + d->rooms[r2].height - 2);
-    x = rand_int_in_range(d->rooms[r2].x + 1, d->rooms[r2].x + d->rooms[r2].width - 2);
-    d->MAP(y, x).type = STAIR_DOWN;
+    y = random_int_in_range(&d->random, d->rooms[r2].y + 1, d->rooms[r2].y + d->rooms[r2].height - 2);
+    x = random_int_in_range(&d->random, d->rooms[r2].x + 1, d->rooms[r2].x + d->rooms[r2].width - 2);
+    d->TYPE(y, x) = STAIR_DOWN;
 }
 
 // Generates a new dungeon. It sets up the dungeon struct itself so it can call init_dungeon() and sets up the binary
-// tree for the partition() function, it then calls the generate_rooms() function, which uses a BSP algorithm to ensure
-// rooms are relatively spread out. If it fails to fill every partition, or makes too many rooms, it will return false
-// as soon as it does. If it fails, makes too few rooms or doesn't cover enough of the map, it will retry, until it has
-// failed too many times. When it generates a workable dungeon, it randomizes the hardness across the array, connects
-// rooms, places stairs, places the PC, cleans up after itself, and returns a pointer to the full dungeon to the caller.
-Dungeon_T *generate_dungeon(int height, int width, int min_rooms, int max_rooms, float percentage_covered) {
-    int tries;
-    bool success;
+// tree for the partition() function, then generates rooms with a BSP algorithm to ensure rooms are relatively spread
+// out. With CONSTRUCTIVE_ROOM_PLACEMENT, generate_rooms_constructively() gets it right in one pass. Otherwise
+// generate_rooms() guesses rooms, returning false as soon as it fails to fill a partition or makes too many rooms, and
+// if it fails, makes too few rooms or doesn't cover enough of the map, it will retry, until it has failed too many
+// times. When it generates a workable dungeon, it randomizes the hardness across the array, connects rooms, places
+// stairs, cleans up after itself, and returns a pointer to the full dungeon to the caller. Stats are always kept, since
+// timing a handful of phases costs next to nothing, and only copied out if the caller wants them.
+Dungeon_T *generate_dungeon(int height, int width, int min_rooms, int max_rooms, float percentage_covered,
+                            uint64_t seed, Generation_Stats_T *stats) {
+    Generation_Stats_T s;
+    struct timespec last;
+    int max_partitions, r;
+    int *stack;
     Dungeon_T *d;
 
+    memset(&s, 0, sizeof(Generation_Stats_T));
+
     // Allocate our dungeon
     d = safe_malloc(sizeof(Dungeon_T));
 
     // Initialize all dungeon variable and draw the border
-    init_dungeon(d, height, width);
+    init_dungeon(d, height, width, seed);
     generate_dungeon_border(d);
 
-    // Try generating our dungeon... if a partition can't be filled, or the dungeon isn't covered enough, or the
-    // number of rooms isn't in range... try again.
-    tries = 0;
-    do {
-
-        // Check to see if we failed after too many tries to generate a dungeon
-        if (tries > FAILED_DUNGEON_GENERATION) {
-            bail(DUNGEON_GENERATION_FAILURE,
-                 "FATAL ERROR! FAILED TO GENERATE WORKABLE DUNGEON AFTER %i TRIES! TRY NEW PARAMETERS!\n",
-                 FAILED_DUNGEON_GENERATION);
-        }
-
-        // Allocate space for room array. generate_rooms will bail if it makes too many and return false. realloc()
-        // will act like malloc() if d-rooms =  NULL.
-        d->rooms = safe_realloc(d->rooms, max_rooms * sizeof(struct Room_S));
-
-        // Try generating rooms... if it makes more than max_rooms, it will bail as soon as it does, returning false
-        // meaning we need to try again to generate new rooms.
-        success = generate_rooms(d, max_rooms);
-        tries++;
+    // Allocate everything generating rooms needs once, for every try. Every leaf partition is at least the minimum
+    // partition size, so there can't be more of them than fit inside the border, and a binary tree has one less inner
+    // partition than it has leaves. The stack never holds more than the whole tree. Allocate space for the room array
+    // too... generating rooms never makes more than max_rooms.
+    max_partitions = 2 * ((height - 2) * (width - 2) / (MIN_PARTITION_HEIGHT * MIN_PARTITION_WIDTH)) + 1;
+    d->partitions = safe_malloc(max_partitions * sizeof(Partition_T));
+    stack = safe_malloc(max_partitions * sizeof(int));
+    d->rooms = safe_malloc(max_rooms * sizeof(Room_T));
+    clock_gettime(CLOCK_MONOTONIC, &last);
+
+    #if CONSTRUCTIVE_ROOM_PLACEMENT == true
+    partition_dungeon(d, stack);
+    s.seconds[PARTITION_PHASE] = lap(&last);
+    generate_rooms_constructively(d, stack, min_rooms, max_rooms, percentage_covered);
+    s.attempts = 1;
+    #else
+    {
+        int tries;
+        bool success;
+
+        // Try generating our dungeon... if a partition can't be filled, or the dungeon isn't covered enough, or the
+        // number of rooms isn't in range... try again.
+        tries = 0;
+        do {
+
+            // Check to see if we failed after too many tries to generate a dungeon
+            if (tries > FAILED_DUNGEON_GENERATION) {
+                bail(DUNGEON_GENERATION_FAILURE,
+                     "FATAL ERROR! FAILED TO GENERATE WORKABLE DUNGEON AFTER %i TRIES! TRY NEW PARAMETERS!\n",
+                     FAILED_DUNGEON_GENERATION);
+            }
 
-        // Try until we have filled every partition, the dungeon is sufficiently covered, and we have enough rooms
-    } while (!success || !is_room_percentage_covered(d, percentage_covered) || min_rooms > d->num_rooms);
+            // Throw out whatever the last try left behind
+            clear_rooms(d);
+
+            // Try generating rooms... if it makes more than max_rooms, it will bail as soon as it does, returning false
+            // meaning we need to try again to generate new rooms.
+            success = generate_rooms(d, stack, max_rooms, &s);
+            tries++;
+
+            // Try until we have filled every partition, the dungeon is sufficiently covered, and we have enough rooms
+            if (success && !is_room_percentage_covered(d, percentage_covered)) {
+                s.failures[COVERAGE_FAILURE]++;
+                success = false;
+            } else if (success && min_rooms > d->num_rooms) {
+                s.failures[TOO_FEW_ROOMS_FAILURE]++;
+                success = false;
+            }
+        } while (!success);
+        s.attempts = tries;
+    }
+    #endif
 
-    // If we generate less rooms than max_rooms, shrink the array so as to not waste memory
+    // If we generate less rooms than max_rooms, shrink the arrays so as to not waste memory. Same for the partitions,
+    // which are kept around with the dungeon.
+    free(stack);
     d->rooms = safe_realloc(d->rooms, d->num_rooms * sizeof(struct Room_S));
+    d->partitions = safe_realloc(d->partitions, d->num_partitions * sizeof(Partition_T));
+    s.seconds[ROOMS_PHASE] = lap(&last);
 
     // Finish up our generation
     randomize_hardness(d);
+    s.seconds[HARDNESS_PHASE] = lap(&last);
     generate_corridors(d);
+    s.seconds[CORRIDORS_PHASE] = lap(&last);
     place_stairs(d);
+    s.seconds[STAIRS_PHASE] = lap(&last);
+
+    // Hand back what it took, if anybody asked
+    if (stats != NULL) {
+        s.num_partitions = d->num_partitions;
+        s.num_rooms = d->num_rooms;
+        for (r = 0; r < d->num_rooms; r++) {
+            s.room_cells += (long long) d->rooms[r].height * d->rooms[r].width;
+        }
+        *stats = s;
+    }
 
     return d;
 }
+
+// See dungeon-random.h
+Dungeon_T *generate_default_dungeon(int height, int width, uint64_t seed, Generation_Stats_T *stats) {
+    long long area, default_area;
+    int min_rooms, max_rooms;
+
+    // Scale the room counts by how much more space there is to fill than in a default dungeon. Rooms are always about
+    // the same size, since the partitions are, so the count grows with the area. Round the minimum down and the maximum
+    // up, so small dungeons stay possible.
+    area = (long long) (height - 2) * (width - 2);
+    default_area = (long long) (DUNGEON_HEIGHT - 2) * (DUNGEON_WIDTH - 2);
+    min_rooms = (int) (MIN_NUM_ROOMS * area / default_area);
+    max_rooms = (int) ((MAX_NUM_ROOMS * area + default_area - 1) / default_area);
+    if (min_rooms < 1) {
+        min_rooms = 1;
+    }
+    if (max_rooms < min_rooms) {
+        max_rooms = min_rooms;
+    }
+
+    return generate_dungeon(height, width, min_rooms, max_rooms, PERCENTAGE_ROOM_COVERED, seed, stats);
+}
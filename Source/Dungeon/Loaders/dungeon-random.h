@@ -1,12 +1,45 @@
 #ifndef ROGUE_DUNGEON_RANDOM_H
 #define ROGUE_DUNGEON_RANDOM_H
 
+#include <stdint.h>
+
 // Forward declare so we don't have to include the dungeon header
 typedef struct Dungeon_S Dungeon_T;
 
+// The steps generating a dungeon goes through, in order. With CONSTRUCTIVE_ROOM_PLACEMENT off, partitions are split as
+// rooms are placed, so all of that time counts as rooms.
+typedef enum Generation_Phase_E {
+    PARTITION_PHASE, ROOMS_PHASE, HARDNESS_PHASE, CORRIDORS_PHASE, STAIRS_PHASE, NUM_GENERATION_PHASES
+} Generation_Phase_T;
+
+// Reasons a try at placing rooms gets thrown out and started over. Only happens with CONSTRUCTIVE_ROOM_PLACEMENT off.
+typedef enum Generation_Failure_E {
+    FILL_FAILURE, TOO_MANY_ROOMS_FAILURE, TOO_FEW_ROOMS_FAILURE, COVERAGE_FAILURE, NUM_GENERATION_FAILURES
+} Generation_Failure_T;
+
+// What it took to generate a dungeon, for tuning dungeon-settings.h. attempts is how many times rooms were placed from
+// scratch, and failures is how many of those were thrown out for each reason. rejected_rooms is how many rooms were
+// guessed and didn't fit, counting every guess in a partition that was given up on. seconds is how long each phase
+// took, and room_cells is how many cells of the map ended up in rooms.
+typedef struct Generation_Stats_S {
+    int attempts, rejected_rooms, num_partitions, num_rooms;
+    int failures[NUM_GENERATION_FAILURES];
+    long long room_cells;
+    double seconds[NUM_GENERATION_PHASES];
+} Generation_Stats_T;
+
 // Returns a pointer to a new dungeon. A few parameters are able to changed at runtime if the user so desires. For now
-// the driver code uses the defaults in setting.h
-Dungeon_T *generate_dungeon(int height, int width, int min_rooms, int max_rooms, float percentage_covered);
+// the driver code uses the defaults in setting.h. The same seed always builds the same dungeon. If stats isn't NULL,
+// what it took to generate the dungeon is stored in it.
+Dungeon_T *generate_dungeon(int height, int width, int min_rooms, int max_rooms, float percentage_covered,
+                            uint64_t seed, Generation_Stats_T *stats);
+
+// Returns a pointer to a new dungeon of the given size, using the defaults in dungeon-settings.h. The room counts are
+// tuned for the default size, so they're scaled by area for anything else. stats is the same as generate_dungeon().
+Dungeon_T *generate_default_dungeon(int height, int width, uint64_t seed, Generation_Stats_T *stats);
 
+// Connects every room in a dungeon with corridors, digging through rock as cheaply as it can. Immutable rock is never
+// dug through. The rooms have to already be marked with mark_dungeon_room().
+void generate_corridors(Dungeon_T *d);
 
 #endif //ROGUE_DUNGEON_RANDOM_H
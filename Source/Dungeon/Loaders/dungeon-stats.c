@@ -0,0 +1,212 @@
+// We have to include this macro so gcc shuts up and will actually compile
+// I think this is what I get for wanting to compile against C11
+#define _POSIX_C_SOURCE 200809L // NOLINT(bugprone-reserved-identifier)
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "dungeon-random.h"
+#include "dungeon-stats.h"
+
+#include "Dungeon/dungeon.h"
+#include "Helpers/helpers.h"
+#include "Helpers/pacer.h"
+#include "Settings/dungeon-settings.h"
+
+// Attempts are counted in buckets of 1, 2, 3-4, 5-8 and so on, doubling each time. Anything past the last bucket goes
+// in it, but that's over a billion attempts.
+#define NUM_ATTEMPT_BUCKETS 31
+
+// How many percent of coverage each coverage bucket holds
+#define COVERAGE_BUCKET_PERCENT 5
+#define NUM_COVERAGE_BUCKETS (100 / COVERAGE_BUCKET_PERCENT + 1)
+
+// How wide the bar for the biggest bucket in a histogram is
+#define HISTOGRAM_WIDTH 40
+
+// Names to print for each phase and each reason an attempt was thrown out, in the order of their enums
+static const char *phase_names[NUM_GENERATION_PHASES] = {"partition", "rooms", "hardness", "corridors", "stairs"};
+static const char *failure_names[NUM_GENERATION_FAILURES] = {"couldn't fill a partition", "too many rooms",
+                                                             "too few rooms", "not enough coverage"};
+
+// Helper for qsort() that orders doubles smallest first
+static int compare_doubles(const void *a, const void *b) {
+    double d1, d2;
+
+    d1 = *(const double *) a;
+    d2 = *(const double *) b;
+    return d1 < d2 ? -1 : d1 > d2;
+}
+
+// Helper that sorts values, and prints the smallest, average, middle, 90th percentile, and largest of them. The average
+// always gets two decimal places, and the rest get precision.
+static void print_distribution(const char *name, double *values, int n, int precision) {
+    double sum;
+    int i;
+
+    qsort(values, n, sizeof(double), compare_doubles);
+    sum = 0;
+    for (i = 0; i < n; i++) {
+        sum += values[i];
+    }
+
+    printf("  %-14s %10.*f %10.2f %10.*f %10.*f %10.*f\n", name, precision, values[0], sum / n, precision,
+           values[n / 2], precision, values[(int) (n * 0.9)], precision, values[n - 1]);
+}
+
+// Helper that prints one bucket of a histogram, with a bar as long as its share of the biggest bucket
+static void print_bucket(const char *label, int n, int biggest, int total) {
+    int i, length;
+
+    // Round the bar up, so a bucket with anything in it always shows
+    length = (n * HISTOGRAM_WIDTH + biggest - 1) / biggest;
+    printf("  %-14s %10i %9.1f%% ", label, n, 100.0 * n / total);
+    for (i = 0; i < length; i++) {
+        putchar('#');
+    }
+    putchar('\n');
+}
+
+// Helper that prints every bucket of a histogram from the first one with anything in it to the last, labeling each
+// with its bounds
+static void print_histogram(const int *buckets, int num_buckets, int total, const int *lower, const int *upper) {
+    char label[32];
+    int first, last, biggest, i;
+
+    first = 0;
+    while (buckets[first] == 0) {
+        first++;
+    }
+    last = num_buckets - 1;
+    while (buckets[last] == 0) {
+        last--;
+    }
+    biggest = 0;
+    for (i = first; i <= last; i++) {
+        biggest = buckets[i] > biggest ? buckets[i] : biggest;
+    }
+
+    for (i = first; i <= last; i++) {
+        if (lower[i] == upper[i]) {
+            snprintf(label, sizeof(label), "%i", lower[i]);
+        } else {
+            snprintf(label, sizeof(label), "%i-%i", lower[i], upper[i]);
+        }
+        print_bucket(label, buckets[i], biggest, total);
+    }
+}
+
+// See dungeon-stats.h
+void report_generation_stats(int count, uint64_t seed, int height, int width) {
+    Generation_Stats_T s;
+    struct timespec start, end;
+    double phases[NUM_GENERATION_PHASES];
+    double *attempts, *rejected, *partitions, *rooms, *coverage;
+    double seconds, total;
+    long long failures[NUM_GENERATION_FAILURES];
+    int attempt_buckets[NUM_ATTEMPT_BUCKETS], attempt_lower[NUM_ATTEMPT_BUCKETS], attempt_upper[NUM_ATTEMPT_BUCKETS];
+    int coverage_buckets[NUM_COVERAGE_BUCKETS], coverage_lower[NUM_COVERAGE_BUCKETS];
+    int coverage_upper[NUM_COVERAGE_BUCKETS];
+    int i, j;
+
+    attempts = safe_malloc(count * sizeof(double));
+    rejected = safe_malloc(count * sizeof(double));
+    partitions = safe_malloc(count * sizeof(double));
+    rooms = safe_malloc(count * sizeof(double));
+    coverage = safe_malloc(count * sizeof(double));
+    for (i = 0; i < NUM_GENERATION_PHASES; i++) {
+        phases[i] = 0;
+    }
+    for (i = 0; i < NUM_GENERATION_FAILURES; i++) {
+        failures[i] = 0;
+    }
+
+    // Bucket i of the attempts holds (2^(i - 1), 2^i], with the first just holding 1
+    for (i = 0; i < NUM_ATTEMPT_BUCKETS; i++) {
+        attempt_buckets[i] = 0;
+        attempt_lower[i] = i == 0 ? 1 : (1 << (i - 1)) + 1;
+        attempt_upper[i] = 1 << i;
+    }
+    for (i = 0; i < NUM_COVERAGE_BUCKETS; i++) {
+        coverage_buckets[i] = 0;
+        coverage_lower[i] = i * COVERAGE_BUCKET_PERCENT;
+        coverage_upper[i] = (i + 1) * COVERAGE_BUCKET_PERCENT;
+    }
+
+    // Generate every dungeon, keeping what it took and throwing the dungeon away
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (i = 0; i < count; i++) {
+        Dungeon_T *d;
+
+        d = generate_default_dungeon(height, width, seed + (uint64_t) i, &s);
+        cleanup_dungeon(d);
+
+        attempts[i] = s.attempts;
+        rejected[i] = s.rejected_rooms;
+        partitions[i] = s.num_partitions;
+        rooms[i] = s.num_rooms;
+        coverage[i] = 100.0 * (double) s.room_cells / ((double) height * width);
+        for (j = 0; j < NUM_GENERATION_PHASES; j++) {
+            phases[j] += s.seconds[j];
+        }
+        for (j = 0; j < NUM_GENERATION_FAILURES; j++) {
+            failures[j] += s.failures[j];
+        }
+
+        // Bucket it up
+        j = 0;
+        while (j < NUM_ATTEMPT_BUCKETS - 1 && attempt_upper[j] < s.attempts) {
+            j++;
+        }
+        attempt_buckets[j]++;
+        j = (int) (coverage[i] / COVERAGE_BUCKET_PERCENT);
+        coverage_buckets[j < NUM_COVERAGE_BUCKETS ? j : NUM_COVERAGE_BUCKETS - 1]++;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    seconds = (double) time_difference(&end, &start) / NANOSECONDS;
+
+    printf("Generated %i %ix%i dungeons (seeds %" PRIu64 " to %" PRIu64 ") in %.3fs (%.1f dungeons/s)\n", count, width,
+           height, seed, seed + (uint64_t) count - 1, seconds, seconds > 0 ? count / seconds : 0);
+    printf("Rooms are placed %s\n",
+           CONSTRUCTIVE_ROOM_PLACEMENT == true ? "constructively" : "by guessing and retrying");
+
+    // How hard it was to get a dungeon out
+    printf("\nAttempts per dungeon\n");
+    print_histogram(attempt_buckets, NUM_ATTEMPT_BUCKETS, count, attempt_lower, attempt_upper);
+    printf("\nThrown out attempts\n");
+    for (i = 0; i < NUM_GENERATION_FAILURES; i++) {
+        printf("  %-26s %12lld\n", failure_names[i], failures[i]);
+    }
+
+    // Where the time went. The total is only generation, not allocating and freeing the dungeons around it.
+    total = 0;
+    for (i = 0; i < NUM_GENERATION_PHASES; i++) {
+        total += phases[i];
+    }
+    printf("\nTime per phase\n");
+    printf("  %-14s %10s %10s %10s\n", "phase", "total (s)", "mean (ms)", "share");
+    for (i = 0; i < NUM_GENERATION_PHASES; i++) {
+        printf("  %-14s %10.4f %10.4f %9.1f%%\n", phase_names[i], phases[i], 1000 * phases[i] / count,
+               total > 0 ? 100 * phases[i] / total : 0);
+    }
+    printf("  %-14s %10.4f %10.4f %9.1f%%\n", "all", total, 1000 * total / count, total > 0 ? 100.0 : 0);
+
+    // What came out
+    printf("\nPer dungeon\n");
+    printf("  %-14s %10s %10s %10s %10s %10s\n", "", "min", "mean", "median", "p90", "max");
+    print_distribution("attempts", attempts, count, 0);
+    print_distribution("rejected rooms", rejected, count, 0);
+    print_distribution("partitions", partitions, count, 0);
+    print_distribution("rooms", rooms, count, 0);
+    print_distribution("coverage (%)", coverage, count, 2);
+    printf("\nCoverage (%%)\n");
+    print_histogram(coverage_buckets, NUM_COVERAGE_BUCKETS, count, coverage_lower, coverage_upper);
+
+    free(attempts);
+    free(rejected);
+    free(partitions);
+    free(rooms);
+    free(coverage);
+}
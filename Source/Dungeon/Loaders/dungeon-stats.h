@@ -0,0 +1,14 @@
+#ifndef ROGUE_DUNGEON_STATS_H
+#define ROGUE_DUNGEON_STATS_H
+
+#include <stdint.h>
+
+// See dungeon-stats.c for helper functions
+
+// Generates count height x width dungeons off of the seeds seed, seed + 1, ... without saving or playing them, and
+// prints a report of what it took to stdout: how many attempts each dungeon needed and why they were thrown out, how
+// long each phase of generation took, and how many rooms and how much coverage came out. Runs on one thread, so the
+// times aren't muddied by other dungeons.
+void report_generation_stats(int count, uint64_t seed, int height, int width);
+
+#endif //ROGUE_DUNGEON_STATS_H
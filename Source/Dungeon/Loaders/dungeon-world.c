@@ -0,0 +1,224 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "dungeon-random.h"
+#include "dungeon-world.h"
+
+#include "Dungeon/dungeon.h"
+#include "Dungeon/world.h"
+#include "Helpers/helpers.h"
+#include "Settings/dungeon-settings.h"
+#include "Settings/exit-codes.h"
+
+// Helper that returns the smaller of two ints
+static int min_int(int a, int b) {
+    return a < b ? a : b;
+}
+
+// Helper that returns the bigger of two ints
+static int max_int(int a, int b) {
+    return a > b ? a : b;
+}
+
+// Helper that adds the part of a chunk's room that's inside of the window's border to the dungeon, if any of it is.
+// (y, x) is where the chunk's top left corner is in the window, and capacity is how many rooms d->rooms has space for.
+static void add_window_room(Dungeon_T *d, const Room_T *room, int y, int x, int *capacity) {
+    int top, left, bottom, right;
+
+    top = max_int(room->y + y, 1);
+    left = max_int(room->x + x, 1);
+    bottom = min_int(room->y + room->height + y, d->height - 1);
+    right = min_int(room->x + room->width + x, d->width - 1);
+    if (top >= bottom || left >= right) {
+        return;
+    }
+
+    if (d->num_rooms == *capacity) {
+        *capacity = *capacity == 0 ? 8 : *capacity * 2;
+        d->rooms = safe_realloc(d->rooms, *capacity * sizeof(Room_T));
+    }
+    d->rooms[d->num_rooms].y = top;
+    d->rooms[d->num_rooms].x = left;
+    d->rooms[d->num_rooms].height = bottom - top;
+    d->rooms[d->num_rooms].width = right - left;
+    d->num_rooms++;
+}
+
+// Helper that finds every piece of corridor the window cut off from all of the rooms, and adds a room one cell big in
+// each of them, so generate_corridors() joins them too. Returns how many rooms there were before.
+static int add_stray_corridors(Dungeon_T *d, int *capacity) {
+    bool *seen;
+    int *queue;
+    int num_rooms, i;
+
+    num_rooms = d->num_rooms;
+    seen = safe_calloc(d->height * d->width, sizeof(bool));
+    queue = safe_malloc(d->height * d->width * sizeof(int));
+
+    for (i = 0; i < d->height * d->width; i++) {
+        int head, tail;
+        bool has_room;
+
+        if (seen[i] || d->types[i] == ROCK) {
+            continue;
+        }
+
+        // Flood the open cells this one is connected to, looking for a room. The window's edge is rock, so this never
+        // walks off of the map.
+        head = 0;
+        tail = 0;
+        queue[tail++] = i;
+        seen[i] = true;
+        has_room = false;
+        while (head < tail) {
+            int c, k, neighbors[4];
+
+            c = queue[head++];
+            has_room = has_room || d->room_ids[c] != NO_ROOM;
+            neighbors[0] = c - d->width;
+            neighbors[1] = c + d->width;
+            neighbors[2] = c - 1;
+            neighbors[3] = c + 1;
+            for (k = 0; k < 4; k++) {
+                if (!seen[neighbors[k]] && d->types[neighbors[k]] != ROCK) {
+                    seen[neighbors[k]] = true;
+                    queue[tail++] = neighbors[k];
+                }
+            }
+        }
+
+        if (!has_room) {
+            Room_T room = {.y = i / d->width, .x = i % d->width, .height = 1, .width = 1};
+
+            add_window_room(d, &room, 0, 0, capacity);
+            mark_dungeon_room(d, d->num_rooms - 1);
+        }
+    }
+
+    // Cleanup
+    free(queue);
+    free(seen);
+
+    return num_rooms;
+}
+
+// See dungeon-world.h
+//
+// Walks every chunk the window covers once, copying the rows of it that are inside the window straight out of its
+// planes. Each chunk only has to stay loaded while it's being copied, so the window can be bigger than the cache.
+Dungeon_T *load_world(World_T *w, int top, int left, int height, int width, uint64_t seed) {
+    Dungeon_T *d;
+    int cy, cx, i, capacity, num_rooms;
+
+    if (top < 0 || left < 0 || top + height > WORLD_HEIGHT || left + width > WORLD_WIDTH) {
+        bail(INVALID_STATE, "FATAL ERROR! WINDOW AT (%i, %i) DOESN'T FIT IN THE WORLD!\n", top, left);
+    }
+
+    d = safe_malloc(sizeof(Dungeon_T));
+    init_dungeon(d, height, width, seed);
+    capacity = 0;
+
+    for (cy = top / WORLD_CHUNK_HEIGHT; cy <= (top + height - 1) / WORLD_CHUNK_HEIGHT; cy++) {
+        for (cx = left / WORLD_CHUNK_WIDTH; cx <= (left + width - 1) / WORLD_CHUNK_WIDTH; cx++) {
+            Chunk_T *c;
+            int y, x, y0, y1, x0, x1;
+
+            // Where the chunk's top left corner lands in the window, and the part of the window it covers
+            c = get_world_chunk(w, cy, cx);
+            y = cy * WORLD_CHUNK_HEIGHT - top;
+            x = cx * WORLD_CHUNK_WIDTH - left;
+            y0 = max_int(y, 0);
+            y1 = min_int(y + WORLD_CHUNK_HEIGHT, height);
+            x0 = max_int(x, 0);
+            x1 = min_int(x + WORLD_CHUNK_WIDTH, width);
+
+            for (i = y0; i < y1; i++) {
+                memcpy(&d->TYPE(i, x0), &c->CHUNK_TYPE(i - y, x0 - x), x1 - x0);
+                memcpy(&d->HARDNESS(i, x0), &c->CHUNK_HARDNESS(i - y, x0 - x), x1 - x0);
+            }
+            for (i = 0; i < c->num_rooms; i++) {
+                add_window_room(d, &c->rooms[i], y, x, &capacity);
+            }
+        }
+    }
+
+    // Wall off the window. Anything on the edge is rock now, so the rooms had to stop short of it.
+    for (i = 0; i < height; i++) {
+        d->TYPE(i, 0) = ROCK;
+        d->TYPE(i, width - 1) = ROCK;
+    }
+    for (i = 0; i < width; i++) {
+        d->TYPE(0, i) = ROCK;
+        d->TYPE(height - 1, i) = ROCK;
+    }
+    generate_dungeon_border(d);
+
+    for (i = 0; i < d->num_rooms; i++) {
+        mark_dungeon_room(d, i);
+    }
+
+    // The window can cut a chunk's rooms off from the corridors joining them, so join them again inside of it. Pieces
+    // of corridor with no room left only get a stand in room while that happens.
+    num_rooms = add_stray_corridors(d, &capacity);
+    if (d->num_rooms > 1) {
+        generate_corridors(d);
+    }
+    for (i = num_rooms; i < d->num_rooms; i++) {
+        d->ROOM_ID(d->rooms[i].y, d->rooms[i].x) = NO_ROOM;
+    }
+    d->num_rooms = num_rooms;
+
+    // Remember what the window looked like, so those corridors are never saved unless something changes them
+    d->world_types = safe_malloc(height * width * sizeof(uint8_t));
+    d->world_hardness = safe_malloc(height * width * sizeof(uint8_t));
+    memcpy(d->world_types, d->types, height * width * sizeof(uint8_t));
+    memcpy(d->world_hardness, d->hardness, height * width * sizeof(uint8_t));
+
+    return d;
+}
+
+// See dungeon-world.h
+//
+// Only cells that changed since the window was loaded are copied back, so a chunk nothing happened in isn't marked and
+// never gets written to disk, and the corridors load_world() joined the window with stay out of the world. What was
+// saved becomes the new snapshot, so saving again only writes what changed after that.
+void save_world(Dungeon_T *d, World_T *w, int top, int left) {
+    int cy, cx, i, j;
+
+    for (cy = top / WORLD_CHUNK_HEIGHT; cy <= (top + d->height - 1) / WORLD_CHUNK_HEIGHT; cy++) {
+        for (cx = left / WORLD_CHUNK_WIDTH; cx <= (left + d->width - 1) / WORLD_CHUNK_WIDTH; cx++) {
+            Chunk_T *c;
+            int y, x, y0, y1, x0, x1;
+
+            // Same as load_world(), but leaving out the window's border
+            c = get_world_chunk(w, cy, cx);
+            y = cy * WORLD_CHUNK_HEIGHT - top;
+            x = cx * WORLD_CHUNK_WIDTH - left;
+            y0 = max_int(y, 1);
+            y1 = min_int(y + WORLD_CHUNK_HEIGHT, d->height - 1);
+            x0 = max_int(x, 1);
+            x1 = min_int(x + WORLD_CHUNK_WIDTH, d->width - 1);
+
+            for (i = y0; i < y1; i++) {
+                int row;
+
+                // Most rows never change, so skip them whole before looking at cells
+                row = i * d->width;
+                if (memcmp(&d->world_types[row + x0], &d->TYPE(i, x0), x1 - x0) == 0 &&
+                    memcmp(&d->world_hardness[row + x0], &d->HARDNESS(i, x0), x1 - x0) == 0) {
+                    continue;
+                }
+
+                for (j = x0; j < x1; j++) {
+                    if (d->world_types[row + j] != d->TYPE(i, j) || d->world_hardness[row + j] != d->HARDNESS(i, j)) {
+                        c->CHUNK_TYPE(i - y, j - x) = d->TYPE(i, j);
+                        c->CHUNK_HARDNESS(i - y, j - x) = d->HARDNESS(i, j);
+                        d->world_types[row + j] = d->TYPE(i, j);
+                        d->world_hardness[row + j] = d->HARDNESS(i, j);
+                        c->dirty = true;
+                    }
+                }
+            }
+        }
+    }
+}
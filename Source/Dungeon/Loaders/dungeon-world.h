@@ -0,0 +1,24 @@
+#ifndef ROGUE_DUNGEON_WORLD_H
+#define ROGUE_DUNGEON_WORLD_H
+
+#include <stdint.h>
+
+// See dungeon-world.c for helper functions
+
+// Forward declare so we don't have to include the dungeon and world headers
+typedef struct Dungeon_S Dungeon_T;
+typedef struct World_S World_T;
+
+// Loads the height x width window of the world with its top left corner at (top, left) into a new dungeon, loading
+// only the chunks it covers. Rooms are cut down to fit inside it, and its outside edge is made immutable rock, so
+// nothing can leave the window. Since that can cut rooms off from each other, they're joined again with corridors
+// inside the window. Those only belong to the window, so the same window always comes out the same. The dungeon's
+// random generator is seeded with seed. The window has to be inside the world.
+Dungeon_T *load_world(World_T *w, int top, int left, int height, int width, uint64_t seed);
+
+// Writes the cells of a dungeon loaded with load_world() that changed since it was loaded back into the world at the
+// same spot, marking every chunk they're in so it gets saved. The outside edge of the window is left alone, since
+// load_world() walled it off.
+void save_world(Dungeon_T *d, World_T *w, int top, int left);
+
+#endif //ROGUE_DUNGEON_WORLD_H
@@ -1,6 +1,5 @@
 #include <limits.h>
 #include <stdlib.h>
-#include <stdio.h>
 #include <Settings/print-settings.h>
 
 #include "dijkstra.h"
@@ -8,6 +7,7 @@
 #include "Dungeon/dungeon.h"
 #include "Helpers/helpers.h"
 #include "Helpers/pairing-heap.h"
+#include "Render/output.h"
 #include "Settings/exit-codes.h"
 #include "Settings/dungeon-settings.h"
 #include "Settings/misc-settings.h"
@@ -29,23 +29,29 @@ typedef struct Vertex_S {
     Heap_Node_T node;
 } Vertex_T;
 
+// Cells waiting to be expanded by generate_room_dijkstra_map(), all reached for the same cost. Grows as needed.
+typedef struct Room_Bucket_S {
+    int *cells;
+    int size, capacity;
+} Room_Bucket_T;
+
 // Cost function for calculating corridor costs during dungeon generation
 static int corridor_cost(const Dungeon_T *d, int y, int x) {
 
     // Infinite cost if we can't go here.
-    if (d->MAP(y + 1, x + 1).hardness == IMMUTABLE_ROCK_HARDNESS) {
+    if (d->HARDNESS(y + 1, x + 1) == IMMUTABLE_ROCK_HARDNESS) {
         return INT_MAX;
     }
 
     // Different cell types have different weights for our corridor map... produces more interesting corridors this way
-    switch (d->MAP(y + 1, x + 1).type) {
+    switch (d->TYPE(y + 1, x + 1)) {
         case ROCK:
             // Checks if we are using hardness... if we are it divides the hardness by a difference to split it into
             // multiple ranges. If there is remainder, we just add it onto the top. Use the compiler to do the magic
             // for us
             #if USE_HARDNESS_FOR_CORRIDORS == true
-            return d->MAP(y + 1, x + 1).hardness / DIFFERENCE > CORR_NUM_HARDNESS_LEVELS ?
-                   CORR_NUM_HARDNESS_LEVELS + 1 : d->MAP(y + 1, x + 1).hardness / DIFFERENCE + 1;
+            return d->HARDNESS(y + 1, x + 1) / DIFFERENCE > CORR_NUM_HARDNESS_LEVELS ?
+                   CORR_NUM_HARDNESS_LEVELS + 1 : d->HARDNESS(y + 1, x + 1) / DIFFERENCE + 1;
             #else
             return 1 + CORR_ROCK_WEIGHT;
             #endif
@@ -67,19 +73,19 @@ static int tunnel_cost(const Dungeon_T *d, int y, int x) {
     static int difference = (MAX_ROCK_HARDNESS - MIN_ROCK_HARDNESS) / TUNNEL_NUM_HARDNESS_LEVELS;
 
     // Infinite cost if we can't go here
-    if (d->MAP(y + 1, x + 1).hardness == IMMUTABLE_ROCK_HARDNESS) {
+    if (d->HARDNESS(y + 1, x + 1) == IMMUTABLE_ROCK_HARDNESS) {
         return INT_MAX;
     }
 
     // Otherwise we can just return hardness... since rooms and corridors have OPEN_SPACE_HARDNESS (0 by default), we
     // can cover that here too, without needing to
-    return 1 + (d->MAP(y + 1, x + 1).hardness / difference);
+    return 1 + (d->HARDNESS(y + 1, x + 1) / difference);
 }
 
 // Cost function for non-tunneling monsters. Regular monsters cannot go through rock, so a cell that is has infinite
 // cost to the algorithm
 static int regular_cost(const Dungeon_T *d, int y, int x) {
-    return d->MAP(y + 1, x + 1).type == ROCK ? INT_MAX : 1;
+    return d->TYPE(y + 1, x + 1) == ROCK ? INT_MAX : 1;
 }
 
 // Helper function to check the neighbors of a cell in the main Dijkstra loop and process them. Cleans up the code and,
@@ -181,7 +187,7 @@ void dijkstra_helper(const Dungeon_T *d, int *cost, bool diagonal, Dijkstra_T ty
             // the floor. Otherwise add all map nodes unconditionally. We already set the cost map above, so we don't
             // have to check for sources.
             if (type == REGULAR_MAP) {
-                if (d->MAP(i + 1, j + 1).type != ROCK) {
+                if (d->TYPE(i + 1, j + 1) != ROCK) {
                     heap_intrusive_insert(h, &DIJKSTRA(i, j).node, COST_TRANSLATE(i, j), &DIJKSTRA(i, j));
                 }
             } else {
@@ -238,46 +244,43 @@ void dijkstra_helper(const Dungeon_T *d, int *cost, bool diagonal, Dijkstra_T ty
     cleanup_heap(h);
 }
 
-// Helper to print to console the cost of each cell... should only be handed 0-9 ever. All it does is print out the
-// number with its corresponding color.
-static void print_cost_helper(int i) {
-    printf("%s", COST_MAP_BACKGROUND);
+// Helper to print to console the cost of each cell... should only be handed 0-9 ever. All it does is add the number
+// with its corresponding color to the output.
+static void print_cost_helper(Output_T *o, int i) {
     switch (i) {
         case 0:
-            printf("%s%i", COST_0, 0);
+            output_cell(o, COST_0, COST_MAP_BACKGROUND, '0');
             break;
         case 1:
-            printf("%s%i", COST_1, 1);
+            output_cell(o, COST_1, COST_MAP_BACKGROUND, '1');
             break;
         case 2:
-            printf("%s%i", COST_2, 2);
+            output_cell(o, COST_2, COST_MAP_BACKGROUND, '2');
             break;
         case 3:
-            printf("%s%i", COST_3, 3);
+            output_cell(o, COST_3, COST_MAP_BACKGROUND, '3');
             break;
         case 4:
-            printf("%s%i", COST_4, 4);
+            output_cell(o, COST_4, COST_MAP_BACKGROUND, '4');
             break;
         case 5:
-            printf("%s%i", COST_5, 5);
+            output_cell(o, COST_5, COST_MAP_BACKGROUND, '5');
             break;
         case 6:
-            printf("%s%i", COST_6, 6);
+            output_cell(o, COST_6, COST_MAP_BACKGROUND, '6');
             break;
         case 7:
-            printf("%s%i", COST_7, 7);
+            output_cell(o, COST_7, COST_MAP_BACKGROUND, '7');
             break;
         case 8:
-            printf("%s%i", COST_8, 8);
+            output_cell(o, COST_8, COST_MAP_BACKGROUND, '8');
             break;
         case 9:
-            printf("%s%i", COST_9, 9);
+            output_cell(o, COST_9, COST_MAP_BACKGROUND, '9');
             break;
         default:
-            printf("%s ", CONSOLE_RESET);
+            output_cell(o, NO_COLOR, NO_COLOR, ' ');
     }
-
-    printf("%s", CONSOLE_RESET);
 }
 
 // Generate dijkstra maps across the dungeon for any type necessary. sources refers an array of tuples representing the
@@ -298,9 +301,9 @@ int *generate_dijkstra_map(const Dungeon_T *d, int num_sources, const int *sourc
         }
     }
 
-    // Fill in our sources
+    // Fill in our sources. They're packed as y, x pairs.
     for (i = 0; i < num_sources; i++) {
-        COST(sources[i * num_sources + 0], sources[i * num_sources + 1]) = 0;
+        COST(sources[i * 2 + 0], sources[i * 2 + 1]) = 0;
     }
 
     // Build our map
@@ -309,6 +312,120 @@ int *generate_dijkstra_map(const Dungeon_T *d, int num_sources, const int *sourc
     return cost;
 }
 
+// Helper for generate_room_dijkstra_map() that adds a cell to a bucket, growing it as needed
+static void push_room_bucket(Room_Bucket_T *b, int c) {
+    if (b->size == b->capacity) {
+        b->capacity = b->capacity == 0 ? ROOM_BUCKET_SIZE : b->capacity * 2;
+        b->cells = safe_realloc(b->cells, b->capacity * sizeof(int));
+    }
+    b->cells[b->size++] = c;
+}
+
+// See dijkstra.h
+//
+// Every step a corridor can take costs a small whole number, at least 1, so this is Dial's version of Dijkstra's:
+// instead of a heap, cells wait in a bucket for the cost it took to reach them, and the buckets are emptied in order.
+// A cell can never be reached for more than the biggest step past the cost being worked on, so only that many buckets
+// plus one are needed, used round robin. A cell is added again whenever a cheaper path to it is found, and the old
+// copy is skipped when it comes up. Every cell is handled a few times at most, so this is linear in the size of the
+// map, where the pairing heap spent most of its time reshuffling.
+int *generate_room_dijkstra_map(const Dungeon_T *d, int *nearest, int *previous) {
+    Room_Bucket_T *buckets;
+    int *cost, *step;
+    int num_buckets, pending, distance, i, j;
+
+    // Nothing has been reached yet. The border can't be dug through, so nothing ever walks off of the map.
+    cost = safe_malloc(d->height * d->width * sizeof(int));
+    step = safe_malloc(d->height * d->width * sizeof(int));
+    num_buckets = 1;
+    for (i = 0; i < d->height; i++) {
+        for (j = 0; j < d->width; j++) {
+            COST(i, j) = INT_MAX;
+            nearest[i * d->width + j] = -1;
+            previous[i * d->width + j] = -1;
+            if (i == 0 || j == 0 || i == d->height - 1 || j == d->width - 1) {
+                step[i * d->width + j] = INT_MAX;
+            } else {
+                step[i * d->width + j] = corridor_cost(d, i - 1, j - 1);
+                if (step[i * d->width + j] != INT_MAX && step[i * d->width + j] + 1 > num_buckets) {
+                    num_buckets = step[i * d->width + j] + 1;
+                }
+            }
+        }
+    }
+
+    // Every room cell is a source. Anything next to one inside of the same room already costs 0, so only the cells on
+    // the edge of a room can lead anywhere, and the rest are left out of the buckets.
+    buckets = safe_calloc(num_buckets, sizeof(Room_Bucket_T));
+    pending = 0;
+    for (i = 1; i < d->height - 1; i++) {
+        for (j = 1; j < d->width - 1; j++) {
+            uint32_t r;
+
+            r = d->ROOM_ID(i, j);
+            if (r == NO_ROOM) {
+                continue;
+            }
+
+            COST(i, j) = 0;
+            nearest[i * d->width + j] = (int) r;
+            if (d->ROOM_ID(i - 1, j) != r || d->ROOM_ID(i + 1, j) != r || d->ROOM_ID(i, j - 1) != r ||
+                d->ROOM_ID(i, j + 1) != r) {
+                push_room_bucket(&buckets[0], i * d->width + j);
+                pending++;
+            }
+        }
+    }
+
+    // Grow every room's region out at once, cheapest first. Anything added while a bucket is being emptied costs more,
+    // so it always lands in a different bucket.
+    for (distance = 0; pending > 0; distance++) {
+        Room_Bucket_T *b;
+
+        b = &buckets[distance % num_buckets];
+        for (i = 0; i < b->size; i++) {
+            int c, k, neighbors[4];
+
+            c = b->cells[i];
+            pending--;
+            if (cost[c] != distance) {
+                continue;
+            }
+
+            neighbors[0] = c - d->width;
+            neighbors[1] = c + d->width;
+            neighbors[2] = c - 1;
+            neighbors[3] = c + 1;
+            for (k = 0; k < 4; k++) {
+                int n;
+
+                // Make sure the cell can be dug through, and that this is actually a cheaper path
+                n = neighbors[k];
+                if (step[n] == INT_MAX || cost[n] <= distance + step[n]) {
+                    continue;
+                }
+
+                // Take the new path, and remember where it came from
+                cost[n] = distance + step[n];
+                nearest[n] = nearest[c];
+                previous[n] = c;
+                push_room_bucket(&buckets[cost[n] % num_buckets], n);
+                pending++;
+            }
+        }
+        b->size = 0;
+    }
+
+    // Cleanup
+    for (i = 0; i < num_buckets; i++) {
+        free(buckets[i].cells);
+    }
+    free(buckets);
+    free(step);
+
+    return cost;
+}
+
 // See dijkstra.h
 void generate_reverse_map(const Dungeon_T *d, int *cost, bool diagonal, Dijkstra_T type) {
     dijkstra_helper(d, cost, diagonal, type);
@@ -316,8 +433,12 @@ void generate_reverse_map(const Dungeon_T *d, int *cost, bool diagonal, Dijkstra
 
 // See dijkstra.h
 void print_dijkstra_map(const Dungeon_T *d, const int *cost, Dijkstra_T type) {
+    Output_T o;
     int i, j;
 
+    // Compose the whole map into one buffer, so it goes out in a single write
+    init_output(&o, d->height * (d->width * (2 * MAX_COLOR_CODE_LENGTH + 1) + sizeof(CONSOLE_RESET)) + 1);
+
     // First check if we have regular map... otherwise tunnel and corridor maps can be printed the same
     // By checking, it lets us add new types of cost maps in the future if we need safely
     if (type == REGULAR_MAP) {
@@ -333,25 +454,26 @@ void print_dijkstra_map(const Dungeon_T *d, const int *cost, Dijkstra_T type) {
                     // Check if it's not a rock... if it has infinite cost and isn't rock, it means a part of the
                     // dungeon that is disconnected from where the character is, and it's impossible to path-find to it.
                     // We want to print these differently than normal rock cells, which also have infinite cost.
-                    if (d->MAP(i, j).type != ROCK) {
-                        printf("%s%s%c%s", COST_MAP_BACKGROUND, COST_IMPOSSIBLE_COLOR, COST_IMPOSSIBLE, CONSOLE_RESET);
+                    if (d->TYPE(i, j) != ROCK) {
+                        output_cell(&o, COST_IMPOSSIBLE_COLOR, COST_MAP_BACKGROUND, COST_IMPOSSIBLE);
                     } else {
-                        printf("%s%c%s", COST_INFINITE_COLOR, COST_INFINITE, CONSOLE_RESET);
+                        output_cell(&o, COST_INFINITE_COLOR, NO_COLOR, COST_INFINITE);
                     }
 
                 } else {
 
                     // We just have a normal cell here.
-                    print_cost_helper(COST(i, j) % 10);
+                    print_cost_helper(&o, COST(i, j) % 10);
                 }
             }
 
             // Print a new line after every row
-            printf("\n");
+            output_reset(&o);
+            output_char(&o, '\n');
         }
 
         // Print a new line after the last row to space multiple maps apart
-        printf("\n");
+        output_char(&o, '\n');
 
     } else if (type == TUNNEL_MAP || type == CORRIDOR_MAP) {
 
@@ -362,20 +484,24 @@ void print_dijkstra_map(const Dungeon_T *d, const int *cost, Dijkstra_T type) {
                 // Check if it's max cost, which means it's an immutable cell. If
                 // both are not true it's just a normal cell that can be printed normally
                 if (COST(i, j) == INT_MAX) {
-                    printf("%s%c%s", COST_INFINITE_COLOR, COST_INFINITE, CONSOLE_RESET);
+                    output_cell(&o, COST_INFINITE_COLOR, NO_COLOR, COST_INFINITE);
 
                 } else {
-                    print_cost_helper(COST(i, j) % 10);
+                    print_cost_helper(&o, COST(i, j) % 10);
                 }
             }
 
             // Print a new line after every row
-            printf("\n");
+            output_reset(&o);
+            output_char(&o, '\n');
         }
 
         // Print a new line after the last row to space multiple maps apart
-        printf("\n");
+        output_char(&o, '\n');
 
     }
-}
 
+    // Write it out and clean up
+    output_flush(&o);
+    cleanup_output(&o);
+}
@@ -20,6 +20,13 @@ typedef enum Dijkstra_E {
 // generate the shortest path and paint a new corridor. See paint_corridor in dungeon.c for details.
 int *generate_dijkstra_map(const Dungeon_T *d, int num_sources, const int *sources, bool diagonal, Dijkstra_T type);
 
+// Generates a corridor cost map out from every room at once, in one pass. Every room cell is a source, so each cell
+// ends up with the cost to reach it from its closest room. nearest gets which room that is, and previous gets the cell
+// (as y * width + x) each cell was reached from, or -1 for room cells, so the cheapest path back to the room can be
+// walked. nearest and previous need to be height * width long. Only moves in the four cardinal directions, like
+// corridors.
+int *generate_room_dijkstra_map(const Dungeon_T *d, int *nearest, int *previous);
+
 // Generate a cost map by updating a new cost mapping. It is used for monsters that are fleeing another. By first
 // generating a normal cost map, then multiplying by some negative multiplier, and rerunning Dijkstra's on it, we end
 // up with a reverse map that can be used for fleeing.
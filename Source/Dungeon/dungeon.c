@@ -2,18 +2,25 @@
 // I think this is what I get for wanting to compile against C11
 #define _POSIX_C_SOURCE 200809L // NOLINT(bugprone-reserved-identifier)
 
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
-#include <time.h>
+#include <string.h>
 
 #include "dungeon.h"
 #include "dijkstra.h"
+#include "fov.h"
 
 #include "Character/character.h"
 #include "Dungeon/Loaders/dungeon-disk.h"
 #include "Dungeon/Loaders/dungeon-random.h"
+#include "Dungeon/Loaders/dungeon-world.h"
 #include "Helpers/helpers.h"
+#include "Helpers/pacer.h"
 #include "Helpers/pairing-heap.h"
+#include "Render/frame.h"
+#include "Render/recording.h"
+#include "Render/renderer.h"
 #include "Settings/character-settings.h"
 #include "Settings/dungeon-settings.h"
 #include "Settings/exit-codes.h"
@@ -22,60 +29,48 @@
 
 // Places a new PC in a room in the dungeon
 static void place_new_pc(Dungeon_T *d) {
-    int room, y, x;
-
-    // Pick room randomly, then pick random coordinate in that room and create the PC.
-    room = rand_int_in_range(0, d->num_rooms - 1);
-    y = rand_int_in_range(d->rooms[room].y, d->rooms[room].y + d->rooms[room].height - 1);
-    x = rand_int_in_range(d->rooms[room].x, d->rooms[room].x + d->rooms[room].width - 1);
-    d->player = new_character(d, y, x, PC_SPEED, 0, PC_SYMBOL, PC_COLOR, true);
-    d->MAP(y, x).character = d->player;
-}
+    int y, x;
 
-// Helper to place a monster in the room. Always places monsters in rooms other than the one the PC is in.
-static bool place_individual_monster(Dungeon_T *d, int player_room) {
-    int tries, room, y, x, speed, behavior;
-    char symbol;
-    char *color;
-
-    // Try placing our monster... if we can't, then print to stderr and return to the place_monsters() loop
-    tries = 0;
-    do {
-
-        // Check to see if we failed after too many tries to place a monster
-        if (tries > FAILED_MONSTER_PLACEMENT) {
-            fprintf(stderr,
-                    "Failed to place monster after %i tries! There will only be %i monsters in the dungeon!\n Try using less monsters!",
-                    FAILED_MONSTER_PLACEMENT, d->num_monsters);
-            return false;
-        }
+    // Pick a random free room cell and create the PC. Nobody else has been placed yet, so every cell is free.
+    build_free_cells(&d->free_cells, d);
+    if (!free_cells_take(&d->free_cells, &d->random, OTHER_ROOM_CELLS, &y, &x)) {
+        bail(DUNGEON_GENERATION_FAILURE, "FATAL ERROR! THERE ARE NO ROOMS TO PLACE THE PLAYER IN!\n");
+    }
+    d->player = new_character(y, x, PC_SPEED, PC_SYMBOL, PC_COLOR);
+    occupancy_set(&d->occupancy, y, x, PC_CHARACTER);
 
-        // Generate our values. This will guarantee monsters are placed in rooms.
-        room = rand_int_in_range(0, d->num_rooms - 1);
-        y = rand_int_in_range(d->rooms[room].y, d->rooms[room].y + d->rooms[room].height - 1);
-        x = rand_int_in_range(d->rooms[room].x, d->rooms[room].x + d->rooms[room].width - 1);
+    // Keep the player's room apart, so monsters don't get placed on top of them
+    free_cells_set_player_room(&d->free_cells, d, find_player_room(d));
+}
 
-        tries++;
-    } while (d->MAP(y, x).character != NULL || room == player_room);
+// Helper to place a monster in the room. Always places monsters in rooms other than the one the PC is in.
+static bool place_individual_monster(Dungeon_T *d) {
+    Character_ID_T id;
+    int y, x, speed, behavior;
+
+    // Pick a free cell out of every room but the player's... if there aren't any left, print to stderr and return to
+    // the place_monsters() loop
+    if (!free_cells_take(&d->free_cells, &d->random, OTHER_ROOM_CELLS, &y, &x)) {
+        fprintf(stderr, "Ran out of room to place monsters! There will only be %i monsters in the dungeon!\n"
+                        " Try using less monsters!\n", d->num_monsters);
+        return false;
+    }
 
     // Set up our speed
-    speed = rand_int_in_range(MIN_MONSTER_SPEED, MAX_MONSTER_SPEED);
+    speed = random_int_in_range(&d->random, MIN_MONSTER_SPEED, MAX_MONSTER_SPEED);
 
     // Set up our monster behavior. It randomly allocates one at a time, using bit shifting to set the proper flag
     behavior = 0;
-    behavior |= rand() % 2 ? INTELLIGENT : 0; // NOLINT(cert-msc50-cpp)
-    behavior |= rand() % 2 ? TELEPATHIC : 0; // NOLINT(cert-msc50-cpp)
-    behavior |= rand() % 2 ? TUNNELER : 0; // NOLINT(cert-msc50-cpp)
-    behavior |= rand() % 2 ? ERRATIC : 0; // NOLINT(cert-msc50-cpp)
-
-    // Set up our display variables
-    symbol = monster_behavior_char(behavior);
-    color = monster_behavior_color(behavior);
+    behavior |= random_bool(&d->random) ? INTELLIGENT : 0;
+    behavior |= random_bool(&d->random) ? TELEPATHIC : 0;
+    behavior |= random_bool(&d->random) ? TUNNELER : 0;
+    behavior |= random_bool(&d->random) ? ERRATIC : 0;
 
     // Place our monster
     d->num_monsters++;
-    d->monsters[d->num_monsters - 1] = new_character(d, y, x, speed, behavior, symbol, color, false);
-    d->MAP(y, x).character = d->monsters[d->num_monsters - 1];
+    id = add_monster(&d->monsters, y, x, speed, behavior);
+    occupancy_set(&d->occupancy, y, x, id);
+    spatial_insert(&d->spatial, id, y, x);
 
     return true;
 }
@@ -83,16 +78,17 @@ static bool place_individual_monster(Dungeon_T *d, int player_room) {
 // Loops through placing monsters in the room. If there were no monsters placed, we have a massive error, and the
 // function bails out.
 static void place_monsters(Dungeon_T *d, int num_monster) {
-    int i, player_room;
+    int i;
 
-    player_room = find_player_room(d, d->player);
+    // Make sure the free cells match the dungeon, since the player might have come from a file
+    build_free_cells(&d->free_cells, d);
 
-    // Allocate space for our monster array
-    d->monsters = malloc(num_monster * sizeof(Character_T *));
+    // Make room for every monster up front
+    reserve_monsters(&d->monsters, num_monster);
 
     // Place monsters one by one randomly
     for (i = 0; i < num_monster; i++) {
-        if (!place_individual_monster(d, player_room)) {
+        if (!place_individual_monster(d)) {
             break;
         }
     }
@@ -102,19 +98,14 @@ static void place_monsters(Dungeon_T *d, int num_monster) {
         bail(DUNGEON_GENERATION_FAILURE,
              "FATAL ERROR! DUNGEONS MUST HAVE MONSTERS! TRY LOADING A DIFFERENT DUNGEON OR USING DIFFERENT PARAMETERS!\n");
     }
-
-    // If we failed to place a monster, shrink our array to not waste memory
-    if (d->num_monsters != num_monster) {
-        d->monsters = safe_realloc(d->monsters, d->num_monsters * sizeof(Character_T *));
-    }
 }
 
 // See dungeon.h
-Dungeon_T *new_random_dungeon(int num_monsters) {
+Dungeon_T *new_random_dungeon(int height, int width, int num_monsters, uint64_t seed) {
     Dungeon_T *d;
 
     // Generate the dungeon
-    d = generate_dungeon(DUNGEON_HEIGHT, DUNGEON_WIDTH, MIN_NUM_ROOMS, MAX_NUM_ROOMS, PERCENTAGE_ROOM_COVERED);
+    d = generate_default_dungeon(height, width, seed, NULL);
 
     // Place our PC
     place_new_pc(d);
@@ -126,11 +117,23 @@ Dungeon_T *new_random_dungeon(int num_monsters) {
 }
 
 // See dungeon.h
-Dungeon_T *new_dungeon_from_disk(const char *path, bool stairs, int num_monsters) {
+Dungeon_T *new_unpopulated_dungeon(int height, int width, uint64_t seed) {
+    Dungeon_T *d;
+
+    // Generate the dungeon and place our PC, since saved dungeons need one
+    d = generate_default_dungeon(height, width, seed, NULL);
+    place_new_pc(d);
+
+    return d;
+}
+
+// See dungeon.h
+Dungeon_T *new_dungeon_from_disk(const char *path, bool stairs, int height, int width, int num_monsters,
+                                 uint64_t seed) {
     Dungeon_T *d;
 
     // Load the dungeon
-    d = load_dungeon(path, stairs);
+    d = load_dungeon(path, stairs, height, width, seed);
 
     // Check if we need to place a player... it means loading failed if we do
     if (d->player == NULL) {
@@ -144,11 +147,12 @@ Dungeon_T *new_dungeon_from_disk(const char *path, bool stairs, int num_monsters
 }
 
 // See dungeon.h
-Dungeon_T *new_dungeon_from_pgm(const char *path, bool stairs, int num_monsters) {
+Dungeon_T *new_dungeon_from_pgm(const char *path, bool stairs, int height, int width, int num_monsters,
+                                uint64_t seed) {
     Dungeon_T *d;
 
     // Load the PGM
-    d = load_pgm(path, stairs);
+    d = load_pgm(path, stairs, height, width, seed);
 
     // Place our PC
     place_new_pc(d);
@@ -159,6 +163,28 @@ Dungeon_T *new_dungeon_from_pgm(const char *path, bool stairs, int num_monsters)
     return d;
 }
 
+// See dungeon.h
+Dungeon_T *new_dungeon_from_world(World_T *w, int top, int left, int height, int width, int num_monsters,
+                                  uint64_t seed) {
+    Dungeon_T *d;
+
+    // Load the window
+    d = load_world(w, top, left, height, width, seed);
+
+    // Place our PC
+    place_new_pc(d);
+
+    // Place our monsters
+    place_monsters(d, num_monsters);
+
+    return d;
+}
+
+// See dungeon.h
+void save_dungeon_to_world(Dungeon_T *d, World_T *w, int top, int left) {
+    save_world(d, w, top, left);
+}
+
 // See dungeon.h
 void save_dungeon_to_disk(Dungeon_T *d, const char *path) {
     save_dungeon(d, path);
@@ -176,116 +202,124 @@ void save_dungeon_to_pgm(Dungeon_T *d, const char *path) {
 // with a character if they die, and then inserting them back into the heap. If the player is killed, the loop cleans
 // up and ends, but if a monster dies, it pulls them off the heap, so they won't be queued anymore, and removes them
 // from the game completely.
-void play_dungeon(Dungeon_T *d) {
+void play_dungeon(Dungeon_T *d, const char *record_path) {
 
     // Local struct for storing heap nodes and characters. This way our heap nodes are associated with a character and
-    // our character with a heap node.
+    // our character with a heap node. Monsters sit at the index of their id, and the player is last.
     typedef struct Character_Node_S {
-        Character_T *c;
+        Character_ID_T id;
         Heap_Node_T n;
     } Character_Node_T;
 
-    // Print the d
-    print_dungeon(d);
-    nanosleep((const struct timespec[]) {{0, 1000000000 / FPS}}, NULL);
-
     Heap_T *h;
+    Renderer_T *r;
+    Recorder_T *recorder;
+    Pacer_T pacer;
     Character_Node_T *characters;
-    int i, j, character_len;
+    int i, character_len;
+    bool died;
+
+    // Start up our render thread and show the starting dungeon. From here on out, drawing never holds up the game.
+    // The game itself is paced off of absolute deadlines, so the time spent moving monsters doesn't slow it down.
+    r = new_renderer(d->height, d->width);
+    init_pacer(&pacer, FPS);
+    renderer_publish(r, d);
+
+    // Record every frame the renderer is handed too, if we were asked to
+    recorder = record_path != NULL ? new_recorder(record_path, d->height, d->width) : NULL;
+    if (recorder != NULL) {
+        record_frame(recorder, d);
+    }
+    pacer_wait(&pacer);
+    died = false;
 
     // Initialize our heap as an intrusive one (see pairing-heap.h for details)
     h = new_heap(true);
 
     // Allocate space for our character array
-    character_len = d->num_monsters + 1;
+    character_len = d->monsters.count + 1;
     characters = safe_malloc((character_len) * sizeof(Character_Node_T));
 
-    // Add characters to the array and heap
-    for (i = 0; i < d->num_monsters; i++) {
-        characters[i].c = d->monsters[i];
-        heap_intrusive_insert(h, &characters[i].n, GAME_SPEED / characters[i].c->speed, &characters[i]);
+    // Add the monsters that are still alive to the array and heap
+    for (i = 0; i < d->monsters.count; i++) {
+        characters[i].id = i;
+        if (d->monsters.alive[i]) {
+            heap_intrusive_insert(h, &characters[i].n, GAME_SPEED / d->monsters.speed[i], &characters[i]);
+        }
     }
 
     // Add our player to the array and heap
-    characters[character_len - 1].c = d->player;
-    heap_intrusive_insert(h, &characters[character_len - 1].n, GAME_SPEED / characters[character_len - 1].c->speed,
+    characters[character_len - 1].id = PC_CHARACTER;
+    heap_intrusive_insert(h, &characters[character_len - 1].n, GAME_SPEED / d->player->speed,
                           &characters[character_len - 1]);
 
-    // Build the cost maps to be safe
+    // Build the cost maps and what the player can see to be safe
     build_dungeon_cost_maps(d, true, true);
+    build_dungeon_fov(d);
 
     // Begin processing our heap. As long as the size is above 2, it means there is a monster and a player on the heap
     // If there isn't, it means the player won.
     while (h->size > 1) {
         Character_Node_T *cn;
-        Character_T *killed;
+        Character_ID_T killed;
 
         // Pull off the next character to move
         cn = heap_remove_min(h)->data;
 
         // Process the player and the monsters differently
-        killed = cn->c->player ? move_player(cn->c) : move_monster(cn->c);
-
-        // Process a character if they were killed
-        if (killed != NULL) {
-            Character_Node_T *cn2 = NULL;
-
-            // Find the killed monster in the characters_array
-            for (i = 0; i < character_len; i++) {
-                if (characters[i].c == killed) {
-                    cn2 = &characters[i];
-                }
-            }
-
-            // Check if the killed character was the player. Otherwise remove the character from the array
-            if (killed->player) {
-                printf("You died! Better luck next time!\n");
-                cn2->c = NULL;
-                cleanup_character(d->player);
-                d->player = NULL;
-                break;
-
-            } else {
-
-                // Remove the killed monster from the game
-                d->MAP(cn2->c->y, cn2->c->x).character = NULL;
-                d->num_monsters--;
-                heap_delete(h, &cn2->n);
+        killed = cn->id == PC_CHARACTER ? move_player(d) : move_monster(d, cn->id);
+
+        // Check if the killed character was the player. Otherwise remove the monster from the game. Its slot in the
+        // store stays put so no other ids change, and whoever killed it is already standing on its cell.
+        if (killed == PC_CHARACTER) {
+            died = true;
+            cleanup_character(d->player);
+            d->player = NULL;
+            break;
 
-                // Destroy the monster completely
-                cleanup_character(cn2->c);
-                cn2->c = NULL;
-            }
+        } else if (killed != NO_CHARACTER) {
+            d->monsters.alive[killed] = false;
+            d->num_monsters--;
+            spatial_remove(&d->spatial, killed, d->monsters.y[killed], d->monsters.x[killed]);
+            heap_delete(h, &characters[killed].n);
         }
 
-        // If the player was the one that moved, print the map, and wait.
-        if (cn->c->player) {
-            print_dungeon(d);
-            nanosleep((const struct timespec[]) {{0, 1000000000 / FPS}}, NULL);
+        // If the player was the one that moved, hand the map off to be drawn, and wait.
+        if (cn->id == PC_CHARACTER) {
+            renderer_publish(r, d);
+            if (recorder != NULL) {
+                record_frame(recorder, d);
+            }
+            pacer_wait(&pacer);
         }
 
-        // Reinsert the monster back into the queue
-        heap_intrusive_insert(h, &cn->n, cn->n.key + (GAME_SPEED / cn->c->speed), cn);
+        // Reinsert the character back into the queue
+        heap_intrusive_insert(h, &cn->n, cn->n.key + (GAME_SPEED / (cn->id == PC_CHARACTER ? d->player->speed :
+                                                                    d->monsters.speed[cn->id])), cn);
     }
 
-    // If we get to this point, the player won or left the dungeon. Rebuild the monster array to be smaller.
-    d->monsters = safe_realloc(d->monsters, d->num_monsters * sizeof(Character_T *));
-    for (i = 0, j = 0; i < character_len; i++) {
-
-        // The number of characters actually in characters (minus the player) are guaranteed to be in lockstep
-        if (characters[i].c != NULL && !characters[i].c->player) {
-            d->monsters[j] = characters[i].c;
-            j++;
-        }
+    // Let the renderer catch up before we tell the player anything, so the message isn't buried in a frame
+    stop_renderer(r);
+    if (died) {
+        printf("You died! Better luck next time!\n");
     }
 
+    // Report how well we kept time
+    print_pacer_stats(&pacer, "Game");
+    print_pacer_stats(&r->pacer, "Renderer");
+
     // Cleanup
+    if (recorder != NULL) {
+        print_recorder_stats(recorder);
+        cleanup_recorder(recorder);
+    }
+    cleanup_renderer(r);
     cleanup_heap(h);
     free(characters);
 }
 
 // See dungeon.h
-void init_dungeon(Dungeon_T *d, int height, int width) {
+void init_dungeon(Dungeon_T *d, int height, int width, uint64_t seed) {
     int i, j;
 
     // Static values
@@ -294,20 +328,44 @@ void init_dungeon(Dungeon_T *d, int height, int width) {
 
     // These will be set later as part of generation
     d->num_rooms = 0;
+    d->num_partitions = 0;
     d->num_monsters = 0;
     d->rooms = NULL;
+    d->partitions = NULL;
     d->player = NULL;
-    d->monsters = NULL;
+    init_monsters(&d->monsters);
+    init_spatial(&d->spatial, height, width, SPATIAL_BLOCK_SIZE);
+    init_free_cells(&d->free_cells, height, width);
+    init_occupancy(&d->occupancy, width);
     d->regular_cost = NULL;
     d->tunnel_cost = NULL;
-
-    // Allocate our map array
-    d->map = safe_malloc(height * width * sizeof(Cell_T));
+    d->regular_flee = NULL;
+    d->tunnel_flee = NULL;
+    d->visible = NULL;
+    d->world_types = NULL;
+    d->world_hardness = NULL;
+    init_random(&d->random, seed);
+
+    // Allocate our map planes, and the room id plane. Nothing is part of a room yet.
+    d->types = safe_malloc(height * width * sizeof(uint8_t));
+    d->hardness = safe_malloc(height * width * sizeof(uint8_t));
+    d->room_ids = safe_malloc(height * width * sizeof(uint32_t));
     for (i = 0; i < d->height; i++) {
         for (j = 0; j < d->width; j++) {
-            d->MAP(i, j).type = DEFAULT_CELL_TYPE;
-            d->MAP(i, j).hardness = DEFAULT_HARDNESS;
-            d->MAP(i, j).character = NULL;
+            d->TYPE(i, j) = DEFAULT_CELL_TYPE;
+            d->HARDNESS(i, j) = DEFAULT_HARDNESS;
+            d->ROOM_ID(i, j) = NO_ROOM;
+        }
+    }
+}
+
+// See dungeon.h
+void mark_dungeon_room(Dungeon_T *d, int r) {
+    int i, j;
+
+    for (i = d->rooms[r].y; i < d->rooms[r].y + d->rooms[r].height; i++) {
+        for (j = d->rooms[r].x; j < d->rooms[r].x + d->rooms[r].width; j++) {
+            d->ROOM_ID(i, j) = (uint32_t) r;
         }
     }
 }
@@ -318,14 +376,14 @@ void generate_dungeon_border(Dungeon_T *d) {
 
     // Left and right
     for (i = 1; i < d->height - 1; i++) {
-        d->MAP(i, 0).hardness = IMMUTABLE_ROCK_HARDNESS;
-        d->MAP(i, d->width - 1).hardness = IMMUTABLE_ROCK_HARDNESS;
+        d->HARDNESS(i, 0) = IMMUTABLE_ROCK_HARDNESS;
+        d->HARDNESS(i, d->width - 1) = IMMUTABLE_ROCK_HARDNESS;
     }
 
     // Top and bottom
     for (i = 0; i < d->width; i++) {
-        d->MAP(0, i).hardness = IMMUTABLE_ROCK_HARDNESS;
-        d->MAP(d->height - 1, i).hardness = IMMUTABLE_ROCK_HARDNESS;
+        d->HARDNESS(0, i) = IMMUTABLE_ROCK_HARDNESS;
+        d->HARDNESS(d->height - 1, i) = IMMUTABLE_ROCK_HARDNESS;
     }
 }
 
@@ -337,113 +395,127 @@ void build_dungeon_cost_maps(Dungeon_T *d, bool regular_map, bool tunnel_map) {
     sources[0][0] = d->player->y;
     sources[0][1] = d->player->x;
 
-    // Build our cost maps
+    // Build our cost maps, and throw out the flee maps that came from the old ones
     if (regular_map) {
         free(d->regular_cost);
+        free(d->regular_flee);
         d->regular_cost = generate_dijkstra_map(d, 1, (int *) sources, CHARACTER_DIAGONAL_TRAVEL, REGULAR_MAP);
+        d->regular_flee = NULL;
     }
     if (tunnel_map) {
         free(d->tunnel_cost);
+        free(d->tunnel_flee);
         d->tunnel_cost = generate_dijkstra_map(d, 1, (int *) sources, CHARACTER_DIAGONAL_TRAVEL, TUNNEL_MAP);
+        d->tunnel_flee = NULL;
     }
 }
 
 // See dungeon.h
-void cleanup_dungeon(Dungeon_T *d) {
+const int *get_dungeon_flee_map(Dungeon_T *d, Dijkstra_T type) {
+    int **flee, *cost;
     int i;
 
-    // Free any monsters in the dungeon
-    for (i = 0; i < d->num_monsters; i++) {
-        cleanup_character(d->monsters[i]);
+    // Figure out which map we're after, and make sure the cost map it comes from is there
+    if (type != REGULAR_MAP && type != TUNNEL_MAP) {
+        bail(INVALID_STATE, "FATAL ERROR! FLEE MAP REQUESTED FOR IMPOSSIBLE ENUM TYPE!");
+    }
+    if (d->regular_cost == NULL || d->tunnel_cost == NULL) {
+        build_dungeon_cost_maps(d, true, true);
+    }
+    flee = type == REGULAR_MAP ? &d->regular_flee : &d->tunnel_flee;
+
+    // Already built since the cost maps last changed, so just share it
+    if (*flee != NULL) {
+        return *flee;
     }
 
-    // Free the rest of our pointers
+    // Scale every reachable cell of the cost map by a negative multiplier, so the cells furthest from the player become
+    // the cheapest, and let Dijkstra's smooth it back out from there. Cells that can't be reached stay that way.
+    cost = safe_malloc(d->height * d->width * sizeof(int));
+    memcpy(cost, type == REGULAR_MAP ? d->regular_cost : d->tunnel_cost, d->height * d->width * sizeof(int));
+    for (i = 0; i < d->height * d->width; i++) {
+        if (cost[i] != INT_MAX) {
+            cost[i] = (int) (cost[i] * FLEE_MULTIPLIER);
+        }
+    }
+    generate_reverse_map(d, cost, CHARACTER_DIAGONAL_TRAVEL, type);
+
+    *flee = cost;
+    return cost;
+}
+
+// See dungeon.h
+void build_dungeon_fov(Dungeon_T *d) {
+    if (d->visible == NULL) {
+        d->visible = safe_malloc(fov_words(d) * sizeof(uint64_t));
+    }
+    generate_fov(d, d->player->y, d->player->x, d->visible);
+}
+
+// See dungeon.h
+void cleanup_dungeon(Dungeon_T *d) {
+
+    // Free all of our pointers
     cleanup_character(d->player);
-    free(d->map);
+    cleanup_monsters(&d->monsters);
+    cleanup_spatial(&d->spatial);
+    cleanup_free_cells(&d->free_cells);
+    cleanup_occupancy(&d->occupancy);
+    free(d->types);
+    free(d->hardness);
+    free(d->world_types);
+    free(d->world_hardness);
     free(d->rooms);
-    free(d->monsters);
+    free(d->partitions);
+    free(d->room_ids);
     free(d->regular_cost);
     free(d->tunnel_cost);
+    free(d->regular_flee);
+    free(d->tunnel_flee);
+    free(d->visible);
     free(d);
 }
 
+// Lookup tables for cell types, generated from CELL_TYPES in dungeon.h
+#define CELL_TYPE_CHAR(type, symbol, plain, color, background) symbol,
+#define CELL_TYPE_PLAIN_CHAR(type, symbol, plain, color, background) plain,
+#define CELL_TYPE_COLOR(type, symbol, plain, color, background) color,
+#define CELL_TYPE_BACKGROUND(type, symbol, plain, color, background) background,
+
+static const char cell_type_chars[NUM_CELL_TYPES] = {CELL_TYPES(CELL_TYPE_CHAR)};
+static const char cell_type_plain_chars[NUM_CELL_TYPES] = {CELL_TYPES(CELL_TYPE_PLAIN_CHAR)};
+static const Color_T cell_type_colors[NUM_CELL_TYPES] = {CELL_TYPES(CELL_TYPE_COLOR)};
+static const Color_T cell_type_backgrounds[NUM_CELL_TYPES] = {CELL_TYPES(CELL_TYPE_BACKGROUND)};
+
 // See dungeon.h
 char cell_type_char(Cell_Type_T c) {
-    switch (c) {
-        case ROCK: // NOLINT(bugprone-branch-clone)
-            return ROCK_CHAR;
-        case ROOM:
-            return ROOM_CHAR;
-        case CORRIDOR:
-            return CORRIDOR_CHAR;
-        case STAIR_UP:
-            return STAIR_UP_CHAR;
-        case STAIR_DOWN:
-            return STAIR_DOWN_CHAR;
-        default:
-            return '?';
-    }
+    return c < NUM_CELL_TYPES ? cell_type_chars[c] : '?';
 }
 
 // See dungeon.h
-char *cell_type_color(Cell_Type_T c) {
-    switch (c) {
-        case ROCK: // NOLINT(bugprone-branch-clone)
-            return ROCK_COLOR;
-        case ROOM:
-            return ROOM_COLOR;
-        case CORRIDOR:
-            return CORRIDOR_COLOR;
-        case STAIR_UP:
-            return STAIR_UP_COLOR;
-        case STAIR_DOWN:
-            return STAIR_DOWN_COLOR;
-        default:
-            return CONSOLE_RESET;
-    }
+char cell_type_plain_char(Cell_Type_T c) {
+    return c < NUM_CELL_TYPES ? cell_type_plain_chars[c] : '?';
 }
 
 // See dungeon.h
-char *cell_type_background(Cell_Type_T c) {
-    switch (c) {
-        case ROCK:
-            return ROCK_BACKGROUND;
-        case ROOM:
-            return ROOM_BACKGROUND;
-        case CORRIDOR:
-            return CORRIDOR_BACKGROUND;
-        case STAIR_UP: // NOLINT(bugprone-branch-clone)
-            return STAIR_UP_BACKGROUND;
-        case STAIR_DOWN:
-            return STAIR_DOWN_BACKGROUND;
-        default:
-            return CONSOLE_RESET;
-    }
+Color_T cell_type_color(Cell_Type_T c) {
+    return c < NUM_CELL_TYPES ? cell_type_colors[c] : NO_COLOR;
 }
 
 // See dungeon.h
-void print_dungeon(const Dungeon_T *d) {
-    int i, j;
-
-    for (i = 0; i < d->height; i++) {
-        for (j = 0; j < d->width; j++) {
-
-            // Check if there's a character. Otherwise print the cell.
-            if (d->MAP(i, j).character != NULL) {
-                printf("%s%s%c%s", cell_type_background(d->MAP(i, j).type), d->MAP(i, j).character->color,
-                       d->MAP(i, j).character->symbol, CONSOLE_RESET);
-            } else {
-                printf("%s%s%c%s", cell_type_background(d->MAP(i, j).type), cell_type_color(d->MAP(i, j).type),
-                       cell_type_char(d->MAP(i, j).type), CONSOLE_RESET);
-            }
-        }
+Color_T cell_type_background(Cell_Type_T c) {
+    return c < NUM_CELL_TYPES ? cell_type_backgrounds[c] : NO_COLOR;
+}
 
-        // Print a new line after every row
-        printf("\n");
-    }
+// See dungeon.h
+void print_dungeon(const Dungeon_T *d) {
+    Frame_T f;
 
-    // Print a new line after the last row to space multiple maps apart
-    printf("\n");
+    // Snapshot the dungeon and draw it the same way the renderer does, all in one write
+    init_frame(&f, d->height, d->width);
+    capture_frame(&f, d);
+    print_frame(&f);
+    cleanup_frame(&f);
 }
 
 // See dungeon.h
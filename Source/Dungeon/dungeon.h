@@ -2,55 +2,132 @@
 #define ROGUE_DUNGEON_H
 
 #include <stdbool.h>
+#include <stdint.h>
 
-// See dungeon.c for helper functions
+#include "Character/character.h"
+#include "Character/spatial.h"
+#include "Dungeon/dijkstra.h"
+#include "Dungeon/free-cells.h"
+#include "Dungeon/occupancy.h"
+#include "Helpers/helpers.h"
+#include "Helpers/random.h"
 
-// Define a macro to help obfuscate bare pointer arithmetic
-#define MAP(a, b) map[(a) * d->width + (b)]
+// See dungeon.c for helper functions
 
-// Forward declare so we don't have to include the character header
-typedef struct Character_S Character_T;
+// Define macros to help obfuscate bare pointer arithmetic. Each reads one plane of the map.
+#define TYPE(a, b) types[(a) * d->width + (b)]
+#define HARDNESS(a, b) hardness[(a) * d->width + (b)]
+#define ROOM_ID(a, b) room_ids[(a) * d->width + (b)]
+
+// What the room id plane holds for cells that aren't part of any room. Rooms are numbered below it, so a dungeon can
+// have at most NO_ROOM of them.
+#define NO_ROOM UINT32_MAX
+
+// Every cell type, as X(type, char, plain char, color, background). The characters and colors are defined in
+// print-settings.h. The plain char is drawn instead of the char when colors are turned off, since otherwise rock, rooms
+// and corridors would all just be blank.
+// Adding a new cell type is just adding a line here: the enum below, the cell_type_*() lookups in dungeon.c, and the
+// glyph tables the renderer uses are all generated from this list.
+#define CELL_TYPES(X) \
+    X(ROCK, ROCK_CHAR, ROCK_PLAIN_CHAR, ROCK_COLOR, ROCK_BACKGROUND) \
+    X(ROOM, ROOM_CHAR, ROOM_PLAIN_CHAR, ROOM_COLOR, ROOM_BACKGROUND) \
+    X(CORRIDOR, CORRIDOR_CHAR, CORRIDOR_PLAIN_CHAR, CORRIDOR_COLOR, CORRIDOR_BACKGROUND) \
+    X(STAIR_UP, STAIR_UP_CHAR, STAIR_UP_PLAIN_CHAR, STAIR_UP_COLOR, STAIR_UP_BACKGROUND) \
+    X(STAIR_DOWN, STAIR_DOWN_CHAR, STAIR_DOWN_PLAIN_CHAR, STAIR_DOWN_COLOR, STAIR_DOWN_BACKGROUND)
 
 // Enum to store the cell type. Allows us to easily add new cell types later if we so desire, and makes code more
-// readable and reliable. Make sure to add the new types to cell_type_char() and cell_type_color()
+// readable and reliable. NUM_CELL_TYPES is always last, so it can be used to size tables.
+#define CELL_TYPE_ENUM(type, symbol, plain, color, background) type,
 typedef enum Cell_Type_E {
-    ROCK, ROOM, CORRIDOR, STAIR_UP, STAIR_DOWN
+    CELL_TYPES(CELL_TYPE_ENUM) NUM_CELL_TYPES
 } Cell_Type_T;
+#undef CELL_TYPE_ENUM
 
-// Stores attributes of a cell inside of the dungeon map. Extensible as long as the corresponding initializer in
-// dungeon.c is updated (init_dungeon()). By having cells keep track of any character on them, it makes printing a lot
-// easier and faster.
-typedef struct Cell_S {
-    Cell_Type_T type;
-    int hardness;
-    Character_T *character;
-} Cell_T;
+// Forward declare so we don't have to include the world header
+typedef struct World_S World_T;
 
 // Stores attributes about a room. y and x refer to the top left point.
 typedef struct Room_S {
     int y, x, height, width;
 } Room_T;
 
+// Stores a partition from the binary space partitioning that laid out a random dungeon. y and x refer to the top left
+// point. left and right are the indexes of its two halves in the dungeon's partition array, or -1 if it was small
+// enough to get a room instead of being split, in which case room is the index of that room.
+typedef struct Partition_S {
+    int y, x, height, width, left, right, room;
+} Partition_T;
+
 // Stores all attributes about a dungeon. Will be expanded upon later as new features are added. Extensible as long as
 // init_dungeon() and cleanup_dungeon() is updated.
+//
+// The map is stored as planes, one byte per cell each, so loops that only care about one of them only pull that one
+// through the cache:
+// - types holds every cell's Cell_Type_T, read with TYPE().
+// - hardness holds every cell's hardness, read with HARDNESS().
+// - room_ids holds which room every cell belongs to, read with ROOM_ID(), so finding a cell's room is one lookup.
+// - visible is a bitset of every cell the player can see, read with VISIBLE() in fov.h.
+// - world_types and world_hardness are the other two as load_world() left them, so save_world() only writes back what
+//   changed since. They're NULL unless the dungeon is a window of a world.
+//
+// Characters:
+// - occupancy has who is standing where, since hardly any cells have anybody on them.
+// - num_monsters is how many monsters are still alive, not how many are in the store.
+// - spatial has every living monster, so they can be looked up by where they're standing.
+// - free_cells has every room cell nobody is standing on, for placing characters.
+//
+// The flee maps are built off of the cost maps the first time a monster asks for one, and thrown out whenever the cost
+// maps change, so every fleeing monster shares the same one. partitions is the tree the rooms of a random dungeon were
+// laid out in, with the first one covering the whole dungeon... dungeons from disk don't have one. Everything random
+// about the dungeon draws from its own generator in random.
 typedef struct Dungeon_S {
-    Cell_T *map;
+    uint8_t *types;
+    uint8_t *hardness;
+    uint8_t *world_types;
+    uint8_t *world_hardness;
     Room_T *rooms;
+    Partition_T *partitions;
+    uint32_t *room_ids;
     Character_T *player;
-    Character_T **monsters;
+    Monsters_T monsters;
+    Spatial_T spatial;
+    Free_Cells_T free_cells;
+    Occupancy_T occupancy;
     int *regular_cost;
     int *tunnel_cost;
-    int height, width, num_rooms, num_monsters;
+    int *regular_flee;
+    int *tunnel_flee;
+    uint64_t *visible;
+    Random_T random;
+    int height, width, num_rooms, num_partitions, num_monsters;
 } Dungeon_T;
 
-// Builds a new dungeon randomly and sets up monsters
-Dungeon_T *new_random_dungeon(int num_monsters);
+// Builds a new height x width dungeon randomly and sets up monsters. The same seed always gives the same dungeon and
+// the same game.
+Dungeon_T *new_random_dungeon(int height, int width, int num_monsters, uint64_t seed);
+
+// Builds a new height x width dungeon randomly with only the player in it, for saving instead of playing. Allocates
+// nothing shared, so any number of these can be built on different threads at once.
+Dungeon_T *new_unpopulated_dungeon(int height, int width, uint64_t seed);
+
+// Builds a new dungeon by loading from disk, seeding its random generator with seed. If loading fails, the random
+// dungeon used instead is height x width.
+Dungeon_T *new_dungeon_from_disk(const char *path, bool stairs, int height, int width, int num_monsters,
+                                 uint64_t seed);
 
-// Builds a new dungeon by loading from disk
-Dungeon_T *new_dungeon_from_disk(const char *path, bool stairs, int num_monsters);
+// Builds a new dungeon by loading from PGM, seeding its random generator with seed. If loading fails, the random
+// dungeon used instead is height x width.
+Dungeon_T *new_dungeon_from_pgm(const char *path, bool stairs, int height, int width, int num_monsters,
+                                uint64_t seed);
 
-// Builds a new dungeon by loading from PGM
-Dungeon_T *new_dungeon_from_pgm(const char *path, bool stairs, int num_monsters);
+// Builds a new dungeon out of the height x width window of a world with its top left corner at (top, left), seeding its
+// random generator with seed. Only the chunks under the window are loaded. See load_world() in dungeon-world.c.
+Dungeon_T *new_dungeon_from_world(World_T *w, int top, int left, int height, int width, int num_monsters,
+                                  uint64_t seed);
+
+// Saves a dungeon built by new_dungeon_from_world() back into the world at the same spot. Only the map is kept... the
+// characters aren't part of the world.
+void save_dungeon_to_world(Dungeon_T *d, World_T *w, int top, int left);
 
 // Saves a dungeon to the disk
 void save_dungeon_to_disk(Dungeon_T *d, const char *path);
@@ -58,33 +135,49 @@ void save_dungeon_to_disk(Dungeon_T *d, const char *path);
 // Saves a dungeon as a PGM
 void save_dungeon_to_pgm(Dungeon_T *d, const char *path);
 
-// Plays out a dungeon, until the player dies, or the monsters all die
-void play_dungeon(Dungeon_T *d);
+// Plays out a dungeon, until the player dies, or the monsters all die. If record_path isn't NULL, every frame is also
+// recorded there to be played back later.
+void play_dungeon(Dungeon_T *d, const char *record_path);
+
+// Initializes a dungeon's variables. Sets num_rooms to be zero, and rooms to NULL, and seeds the dungeon's random
+// generator. This is the function to be sure to update if the map gets another plane.
+void init_dungeon(Dungeon_T *d, int height, int width, uint64_t seed);
 
-// Initializes a dungeon's variables. Sets num_rooms to be zero, and rooms to NULL. This is the function to be sure to
-// update if Cell_T is extended.
-void init_dungeon(Dungeon_T *d, int height, int width);
+// Stamps room r onto the room id plane, over every cell it covers. Generators and loaders have to call this for every
+// room they add.
+void mark_dungeon_room(Dungeon_T *d, int r);
 
 // Runs along all sises of the dungeon, setting the immutable flag on them so they cannot be changed. Used by
 // loag_pgm() in dungeon-disk.c
 void generate_dungeon_border(Dungeon_T *d);
 
-// Builds global dijkstra maps for the dungeon, centered around the player character
+// Builds global dijkstra maps for the dungeon, centered around the player character. Throws out the flee maps built
+// off of them.
 void build_dungeon_cost_maps(Dungeon_T *d, bool regular_map, bool tunnel_map);
 
+// Returns the map a monster should roll downhill on to get away from the player, either REGULAR_MAP or TUNNEL_MAP. It's
+// built the first time it's asked for after the cost maps change, and shared after that.
+const int *get_dungeon_flee_map(Dungeon_T *d, Dijkstra_T type);
+
+// Rebuilds the set of cells the player can see. Has to be called whenever the player moves or rock is dug out.
+void build_dungeon_fov(Dungeon_T *d);
+
 // Cleans up a dungeon, freeing all child structs and arrays.
 void cleanup_dungeon(Dungeon_T *d);
 
 // Returns the char type of a cell type.
 char cell_type_char(Cell_Type_T c);
 
-// Returns the ASCI control string to color a cell type.
-char *cell_type_color(Cell_Type_T c);
+// Returns the char to draw a cell type with when colors are turned off
+char cell_type_plain_char(Cell_Type_T c);
+
+// Returns the color to draw a cell type in.
+Color_T cell_type_color(Cell_Type_T c);
 
-// Returns the ASCI control string to color the background of a cell type
-char *cell_type_background(Cell_Type_T c);
+// Returns the color to draw the background of a cell type in
+Color_T cell_type_background(Cell_Type_T c);
 
-// Iterates through the dungeon and prints it out. Calls cell_type_char() and cell_type_color() to print it.
+// Snapshots the dungeon into a frame and prints it out in a single write. See render_frame() in frame.c.
 void print_dungeon(const Dungeon_T *d);
 
 // Prints the dungeon's cost maps... will create those cost maps if it has to.
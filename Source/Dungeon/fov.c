@@ -0,0 +1,107 @@
+#include <string.h>
+
+#include "fov.h"
+
+#include "Dungeon/dungeon.h"
+
+// Transforms that map the first octant onto each of the eight, as (xx, xy, yx, yy)
+static const int octants[8][4] = {
+        {1,  0,  0,  1},
+        {0,  1,  1,  0},
+        {0,  -1, 1,  0},
+        {-1, 0,  0,  1},
+        {-1, 0,  0,  -1},
+        {0,  -1, -1, 0},
+        {0,  1,  -1, 0},
+        {1,  0,  0,  -1}
+};
+
+// Helper that marks a single cell as visible
+static void set_visible(const Dungeon_T *d, uint64_t *visible, int y, int x) {
+    visible[(y * d->width + x) >> 6] |= (uint64_t) 1 << ((y * d->width + x) & 63);
+}
+
+// Helper that scans one octant outwards from row, between the start and end slopes. Whenever a run of rock is found,
+// the rest of the octant behind the open cells before it is scanned recursively, and the scan carries on past it with a
+// narrower slope. Based on the well known RogueBasin version of the algorithm.
+static void cast_light(const Dungeon_T *d, uint64_t *visible, int y, int x, int row, double start, double end,
+                       int radius, const int *transform) {
+    double next_start;
+    int i;
+
+    if (start < end) {
+        return;
+    }
+
+    next_start = start;
+    for (i = row; i <= radius; i++) {
+        int delta_x, delta_y;
+        bool blocked;
+
+        delta_y = -i;
+        blocked = false;
+        for (delta_x = -i; delta_x <= 0; delta_x++) {
+            double left, right;
+            int cell_y, cell_x;
+
+            // Translate into the octant we're scanning
+            cell_x = x + delta_x * transform[0] + delta_y * transform[1];
+            cell_y = y + delta_x * transform[2] + delta_y * transform[3];
+            left = (delta_x - 0.5) / (delta_y + 0.5);
+            right = (delta_x + 0.5) / (delta_y - 0.5);
+
+            // Skip anything outside of the slopes we're scanning, or outside of the dungeon
+            if (start < right) {
+                continue;
+            }
+            if (end > left) {
+                break;
+            }
+            if (cell_y < 0 || cell_y >= d->height || cell_x < 0 || cell_x >= d->width) {
+                continue;
+            }
+
+            set_visible(d, visible, cell_y, cell_x);
+
+            // Keep track of when we go in and out of rock
+            if (blocked) {
+                if (d->TYPE(cell_y, cell_x) == ROCK) {
+                    next_start = right;
+                } else {
+                    blocked = false;
+                    start = next_start;
+                }
+            } else if (d->TYPE(cell_y, cell_x) == ROCK && i < radius) {
+                blocked = true;
+                cast_light(d, visible, y, x, i + 1, start, left, radius, transform);
+                next_start = right;
+            }
+        }
+
+        // If the row ended in rock, everything further out has already been handled by the recursion
+        if (blocked) {
+            break;
+        }
+    }
+}
+
+// See fov.h
+int fov_words(const Dungeon_T *d) {
+    return (d->height * d->width + 63) / 64;
+}
+
+// See fov.h
+void generate_fov(const Dungeon_T *d, int y, int x, uint64_t *visible) {
+    int i, radius;
+
+    memset(visible, 0, fov_words(d) * sizeof(uint64_t));
+
+    // We can always see where we're standing
+    set_visible(d, visible, y, x);
+
+    // Nothing can be farther away than the longest side of the dungeon
+    radius = d->height > d->width ? d->height : d->width;
+    for (i = 0; i < 8; i++) {
+        cast_light(d, visible, y, x, 1, 1.0, 0.0, radius, octants[i]);
+    }
+}
@@ -0,0 +1,25 @@
+#ifndef ROGUE_FOV_H
+#define ROGUE_FOV_H
+
+#include <stdint.h>
+
+// See fov.c for helper functions.
+
+// Define a macro to help obfuscate bare bit twiddling. Reads if a cell is set in the dungeon's visibility bitset.
+// Unlike TYPE() it's used without the d->, since the whole expression has to be wrapped up for it to be safe to negate
+// or compare.
+#define VISIBLE(a, b) ((d->visible[((a) * d->width + (b)) >> 6] >> (((a) * d->width + (b)) & 63)) & 1)
+
+// Forward declare so we don't have to include the dungeon header
+typedef struct Dungeon_S Dungeon_T;
+
+// Returns how many 64 bit words a visibility bitset for the dungeon needs
+int fov_words(const Dungeon_T *d);
+
+// Fills in a visibility bitset with every cell that can be seen from the given cell, using recursive shadowcasting.
+// Rock blocks sight, but is itself visible, so walls around the viewer are lit up too. Every octant is scanned once,
+// row by row outwards, and anything behind rock is skipped over entirely, so it's a single pass that touches each
+// visible cell about once no matter how many things need to check visibility afterwards.
+void generate_fov(const Dungeon_T *d, int y, int x, uint64_t *visible);
+
+#endif //ROGUE_FOV_H
@@ -0,0 +1,161 @@
+#include <stdlib.h>
+
+#include "free-cells.h"
+
+#include "Character/character.h"
+#include "Dungeon/dungeon.h"
+#include "Helpers/helpers.h"
+
+// Helper that appends a cell onto the end of a list
+static void push_cell(Free_Cells_T *f, int list, int c) {
+    f->position[c] = f->count[list];
+    f->cells[list][f->count[list]] = c;
+    f->count[list]++;
+}
+
+// Helper that takes a cell out of its list, by moving the last cell in the list into its spot
+static void pop_cell(Free_Cells_T *f, int c) {
+    int list, last;
+
+    list = f->list[c];
+    last = f->cells[list][f->count[list] - 1];
+    f->cells[list][f->position[c]] = last;
+    f->position[last] = f->position[c];
+    f->position[c] = -1;
+    f->count[list]--;
+}
+
+// Helper that switches which list a room cell belongs to, carrying it over if it's free
+static void move_cell(Free_Cells_T *f, int c, int list) {
+    if (f->position[c] != -1) {
+        pop_cell(f, c);
+        f->list[c] = (signed char) list;
+        push_cell(f, list, c);
+    } else {
+        f->list[c] = (signed char) list;
+    }
+}
+
+// Helper that moves every cell of a room into a list. Only has to look inside of the room's bounds.
+static void move_room(Free_Cells_T *f, const Dungeon_T *d, int r, int list) {
+    int i, j;
+
+    for (i = d->rooms[r].y; i < d->rooms[r].y + d->rooms[r].height; i++) {
+        for (j = d->rooms[r].x; j < d->rooms[r].x + d->rooms[r].width; j++) {
+            if (d->ROOM_ID(i, j) == (uint32_t) r) {
+                move_cell(f, i * f->width + j, list);
+            }
+        }
+    }
+}
+
+// See free-cells.h
+void init_free_cells(Free_Cells_T *f, int height, int width) {
+    int i;
+
+    f->width = width;
+    f->player_room = -1;
+    f->position = safe_malloc(height * width * sizeof(int));
+    f->list = safe_malloc(height * width * sizeof(signed char));
+    for (i = 0; i < NUM_FREE_LISTS; i++) {
+        f->cells[i] = safe_malloc(height * width * sizeof(int));
+        f->count[i] = 0;
+    }
+
+    // Nothing is part of a room until the lists are built
+    for (i = 0; i < height * width; i++) {
+        f->position[i] = -1;
+        f->list[i] = -1;
+    }
+}
+
+// See free-cells.h
+void build_free_cells(Free_Cells_T *f, const Dungeon_T *d) {
+    int i, j;
+
+    // Start over from nothing
+    for (i = 0; i < NUM_FREE_LISTS; i++) {
+        f->count[i] = 0;
+    }
+    f->player_room = -1;
+
+    // Every room cell starts off in the other list, and only goes on it if nobody is standing there
+    for (i = 0; i < d->height; i++) {
+        for (j = 0; j < d->width; j++) {
+            f->position[i * f->width + j] = -1;
+            f->list[i * f->width + j] = -1;
+            if (d->ROOM_ID(i, j) != NO_ROOM) {
+                f->list[i * f->width + j] = OTHER_ROOM_CELLS;
+                if (occupancy_get(&d->occupancy, i, j) == NO_CHARACTER) {
+                    push_cell(f, OTHER_ROOM_CELLS, i * f->width + j);
+                }
+            }
+        }
+    }
+
+    // Split off the player's room, if there's a player yet
+    if (d->player != NULL) {
+        free_cells_set_player_room(f, d, find_player_room(d));
+    }
+}
+
+// See free-cells.h
+void free_cells_add(Free_Cells_T *f, int y, int x) {
+    int c;
+
+    c = y * f->width + x;
+    if (f->list[c] != -1 && f->position[c] == -1) {
+        push_cell(f, f->list[c], c);
+    }
+}
+
+// See free-cells.h
+void free_cells_remove(Free_Cells_T *f, int y, int x) {
+    int c;
+
+    c = y * f->width + x;
+    if (f->position[c] != -1) {
+        pop_cell(f, c);
+    }
+}
+
+// See free-cells.h
+bool free_cells_take(Free_Cells_T *f, Random_T *r, Free_List_T list, int *y, int *x) {
+    int c;
+
+    if (f->count[list] == 0) {
+        return false;
+    }
+
+    c = f->cells[list][random_bounded(r, (uint32_t) f->count[list])];
+    pop_cell(f, c);
+    *y = c / f->width;
+    *x = c % f->width;
+    return true;
+}
+
+// See free-cells.h
+void free_cells_set_player_room(Free_Cells_T *f, const Dungeon_T *d, int room) {
+    if (room == f->player_room) {
+        return;
+    }
+
+    if (f->player_room != -1) {
+        move_room(f, d, f->player_room, OTHER_ROOM_CELLS);
+    }
+    if (room != -1) {
+        move_room(f, d, room, PLAYER_ROOM_CELLS);
+    }
+    f->player_room = room;
+}
+
+// See free-cells.h
+void cleanup_free_cells(Free_Cells_T *f) {
+    int i;
+
+    for (i = 0; i < NUM_FREE_LISTS; i++) {
+        free(f->cells[i]);
+    }
+    free(f->position);
+    free(f->list);
+}
@@ -0,0 +1,56 @@
+#ifndef ROGUE_FREE_CELLS_H
+#define ROGUE_FREE_CELLS_H
+
+#include <stdbool.h>
+
+#include "Helpers/random.h"
+
+// See free-cells.c for helper functions
+
+// Forward declare so we don't have to include the dungeon header
+typedef struct Dungeon_S Dungeon_T;
+
+// The two lists free cells are kept in. Monsters are never placed in the room the player is in, so its cells are kept
+// apart from the rest.
+typedef enum Free_List_E {
+    PLAYER_ROOM_CELLS, OTHER_ROOM_CELLS, NUM_FREE_LISTS
+} Free_List_T;
+
+// Every room cell nobody is standing on, so characters can be placed with one random pick instead of guessing until a
+// free spot turns up. Cells are stored as their index in the map (row * width + column). Each list is unordered, and
+// cells are removed by swapping the last one into their spot, so adding, removing, and picking are all constant time.
+//
+// list holds which list every cell of the map belongs to, or -1 if it isn't part of a room. position holds where a cell
+// sits in its list, or -1 if somebody is standing on it.
+typedef struct Free_Cells_S {
+    int *cells[NUM_FREE_LISTS];
+    int count[NUM_FREE_LISTS];
+    int *position;
+    signed char *list;
+    int width, player_room;
+} Free_Cells_T;
+
+// Initializes empty lists for a dungeon of the given size
+void init_free_cells(Free_Cells_T *f, int height, int width);
+
+// Fills the lists from scratch off of the rooms and characters in the dungeon. Has to be called once the rooms are all
+// in, before anything is placed off of the lists. If there's a player, the room they're in goes in its own list.
+void build_free_cells(Free_Cells_T *f, const Dungeon_T *d);
+
+// Marks a cell as free, since whoever was standing there left. Nothing happens if it isn't a room cell.
+void free_cells_add(Free_Cells_T *f, int y, int x);
+
+// Marks a cell as taken. Nothing happens if it wasn't free.
+void free_cells_remove(Free_Cells_T *f, int y, int x);
+
+// Picks a random free cell out of a list with r, storing it in y and x, and marks it as taken. Returns false if the
+// list is empty.
+bool free_cells_take(Free_Cells_T *f, Random_T *r, Free_List_T list, int *y, int *x);
+
+// Moves cells between the lists when the player changes rooms. room is -1 if the player isn't in one.
+void free_cells_set_player_room(Free_Cells_T *f, const Dungeon_T *d, int room);
+
+// Frees the lists, but not the struct itself
+void cleanup_free_cells(Free_Cells_T *f);
+
+#endif //ROGUE_FREE_CELLS_H
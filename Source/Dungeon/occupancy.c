@@ -0,0 +1,148 @@
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "occupancy.h"
+
+#include "Helpers/helpers.h"
+
+// How many slots a new table starts with. Has to be a power of two, since slots are wrapped around with a mask.
+#define STARTING_SIZE 16
+
+// What an empty slot holds instead of a cell
+#define EMPTY_SLOT (-1)
+
+// Helper that returns the slot a cell belongs in, if nothing is in the way. The cell is mixed up first (murmur3's
+// finalizer), so cells in the same column of a map with a power of two width don't all land on top of each other.
+static int home_slot(const Occupancy_T *o, int c) {
+    uint32_t h;
+
+    h = (uint32_t) c;
+    h ^= h >> 16;
+    h *= 0x85ebca6bU;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35U;
+    h ^= h >> 16;
+    return (int) (h & (uint32_t) (o->size - 1));
+}
+
+// Helper that finds the slot a cell is in, or the empty slot it would go in if it isn't
+static int find_slot(const Occupancy_T *o, int c) {
+    int s;
+
+    s = home_slot(o, c);
+    while (o->cells[s] != EMPTY_SLOT && o->cells[s] != c) {
+        s = (s + 1) & (o->size - 1);
+    }
+    return s;
+}
+
+// Helper that allocates an empty table with size slots
+static void allocate_slots(Occupancy_T *o, int size) {
+    int i;
+
+    o->size = size;
+    o->count = 0;
+    o->cells = safe_malloc(size * sizeof(int));
+    o->characters = safe_malloc(size * sizeof(Character_ID_T));
+    for (i = 0; i < size; i++) {
+        o->cells[i] = EMPTY_SLOT;
+    }
+}
+
+// Helper that doubles the table, putting everything back in where it belongs in the bigger one
+static void grow_slots(Occupancy_T *o) {
+    Character_ID_T *characters;
+    int *cells;
+    int size, i;
+
+    cells = o->cells;
+    characters = o->characters;
+    size = o->size;
+    allocate_slots(o, size * 2);
+    for (i = 0; i < size; i++) {
+        if (cells[i] != EMPTY_SLOT) {
+            int s;
+
+            s = find_slot(o, cells[i]);
+            o->cells[s] = cells[i];
+            o->characters[s] = characters[i];
+            o->count++;
+        }
+    }
+
+    free(cells);
+    free(characters);
+}
+
+// Helper that empties a slot. Anything after it that was pushed past where it belongs is shifted back into the hole,
+// so every cell can still be found by probing forward from its home slot without running into an empty slot first.
+static void remove_slot(Occupancy_T *o, int s) {
+    int next, home, mask;
+
+    mask = o->size - 1;
+    next = s;
+    while (true) {
+        next = (next + 1) & mask;
+        if (o->cells[next] == EMPTY_SLOT) {
+            break;
+        }
+
+        // It can move back if the hole is between its home and where it is now
+        home = home_slot(o, o->cells[next]);
+        if (((next - home) & mask) >= ((next - s) & mask)) {
+            o->cells[s] = o->cells[next];
+            o->characters[s] = o->characters[next];
+            s = next;
+        }
+    }
+
+    o->cells[s] = EMPTY_SLOT;
+    o->count--;
+}
+
+// See occupancy.h
+void init_occupancy(Occupancy_T *o, int width) {
+    o->width = width;
+    allocate_slots(o, STARTING_SIZE);
+}
+
+// See occupancy.h
+Character_ID_T occupancy_get(const Occupancy_T *o, int y, int x) {
+    int s;
+
+    s = find_slot(o, y * o->width + x);
+    return o->cells[s] == EMPTY_SLOT ? NO_CHARACTER : o->characters[s];
+}
+
+// See occupancy.h
+void occupancy_set(Occupancy_T *o, int y, int x, Character_ID_T id) {
+    int c, s;
+
+    c = y * o->width + x;
+    s = find_slot(o, c);
+
+    // Clearing a cell nobody is on does nothing
+    if (id == NO_CHARACTER) {
+        if (o->cells[s] == c) {
+            remove_slot(o, s);
+        }
+        return;
+    }
+
+    // Take a new slot if the cell isn't in the table yet, growing first if it would end up more than half full
+    if (o->cells[s] != c) {
+        if (2 * (o->count + 1) > o->size) {
+            grow_slots(o);
+            s = find_slot(o, c);
+        }
+        o->cells[s] = c;
+        o->count++;
+    }
+    o->characters[s] = id;
+}
+
+// See occupancy.h
+void cleanup_occupancy(Occupancy_T *o) {
+    free(o->cells);
+    free(o->characters);
+}
@@ -0,0 +1,31 @@
+#ifndef ROGUE_OCCUPANCY_H
+#define ROGUE_OCCUPANCY_H
+
+#include "Character/character.h"
+
+// See occupancy.c for helper functions
+
+// Which character is standing on which cell. Only a handful of cells ever have anybody on them, so instead of a whole
+// plane the size of the map, it's a hash table from cell (row * width + column) to character, sized off of how many
+// characters there are. It's open addressing with linear probing, kept at most half full so lookups almost always hit
+// on the first slot, and removing shifts the cells after it back instead of leaving tombstones, so it never slows down
+// as characters move around.
+typedef struct Occupancy_S {
+    int *cells;
+    Character_ID_T *characters;
+    int width, size, count;
+} Occupancy_T;
+
+// Initializes an empty table for a dungeon of the given width
+void init_occupancy(Occupancy_T *o, int width);
+
+// Returns the character standing on (y, x), or NO_CHARACTER if nobody is
+Character_ID_T occupancy_get(const Occupancy_T *o, int y, int x);
+
+// Sets who is standing on (y, x), replacing whoever was. Setting NO_CHARACTER clears the cell.
+void occupancy_set(Occupancy_T *o, int y, int x, Character_ID_T id);
+
+// Frees the table, but not the struct itself
+void cleanup_occupancy(Occupancy_T *o);
+
+#endif //ROGUE_OCCUPANCY_H
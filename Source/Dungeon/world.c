@@ -0,0 +1,518 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "world.h"
+
+#include "Dungeon/Loaders/dungeon-random.h"
+#include "Helpers/helpers.h"
+#include "Helpers/random.h"
+#include "Settings/dungeon-settings.h"
+#include "Settings/exit-codes.h"
+#include "Settings/file-settings.h"
+
+// How many cells each plane of a chunk has
+#define CHUNK_CELLS (WORLD_CHUNK_HEIGHT * WORLD_CHUNK_WIDTH)
+
+// What an empty slot of the table holds instead of a chunk
+#define EMPTY_SLOT (-1)
+
+// Longest a seed can be written out in decimal, and the longest a chunk's row or column can
+#define MAX_SEED_DIGITS 20
+#define MAX_COORDINATE_DIGITS 10
+
+// Bytes in a chunk file before the rooms: the marker, version, seed, row, column, height, width and number of rooms
+#define CHUNK_HEADER_SIZE (sizeof(CHUNK_FILE_MARKER) - 1 + sizeof(uint32_t) * 3 + sizeof(uint64_t) + \
+                           sizeof(uint16_t) * 3)
+
+// Biggest a chunk file can be, with a room in every cell
+#define MAX_CHUNK_FILE_SIZE (CHUNK_HEADER_SIZE + (sizeof(uint16_t) * 4 + 2) * CHUNK_CELLS)
+
+// Helper that returns which chunk (row * num_columns + column) is in a slot
+static int chunk_key(const World_T *w, int slot) {
+    return w->chunks[slot].y * w->num_columns + w->chunks[slot].x;
+}
+
+// Helper that returns the spot in the table a chunk belongs in, if nothing is in the way. Mixed up the same way as the
+// occupancy table, so a column of chunks doesn't all land on top of each other.
+static int home_slot(const World_T *w, int key) {
+    uint32_t h;
+
+    h = (uint32_t) key;
+    h ^= h >> 16;
+    h *= 0x85ebca6bU;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35U;
+    h ^= h >> 16;
+    return (int) (h & (uint32_t) (w->table_size - 1));
+}
+
+// Helper that finds the spot in the table a chunk is in, or the empty spot it would go in if it isn't cached
+static int find_slot(const World_T *w, int key) {
+    int s;
+
+    s = home_slot(w, key);
+    while (w->table[s] != EMPTY_SLOT && chunk_key(w, w->table[s]) != key) {
+        s = (s + 1) & (w->table_size - 1);
+    }
+    return s;
+}
+
+// Helper that takes a chunk out of the table, shifting anything after it back into the hole the same way the occupancy
+// table does
+static void remove_slot(World_T *w, int key) {
+    int s, next, home, mask;
+
+    mask = w->table_size - 1;
+    s = find_slot(w, key);
+    next = s;
+    while (true) {
+        next = (next + 1) & mask;
+        if (w->table[next] == EMPTY_SLOT) {
+            break;
+        }
+
+        // It can move back if the hole is between its home and where it is now
+        home = home_slot(w, chunk_key(w, w->table[next]));
+        if (((next - home) & mask) >= ((next - s) & mask)) {
+            w->table[s] = w->table[next];
+            s = next;
+        }
+    }
+
+    w->table[s] = EMPTY_SLOT;
+}
+
+// Helper that unhooks a slot from the list of most to least recently used
+static void unlink_slot(World_T *w, int slot) {
+    Chunk_T *c;
+
+    c = &w->chunks[slot];
+    if (c->newer != -1) {
+        w->chunks[c->newer].older = c->older;
+    } else {
+        w->newest = c->older;
+    }
+    if (c->older != -1) {
+        w->chunks[c->older].newer = c->newer;
+    } else {
+        w->oldest = c->newer;
+    }
+}
+
+// Helper that hooks a slot onto the front of the list, as the most recently used
+static void link_slot(World_T *w, int slot) {
+    w->chunks[slot].newer = -1;
+    w->chunks[slot].older = w->newest;
+    if (w->newest != -1) {
+        w->chunks[w->newest].newer = slot;
+    } else {
+        w->oldest = slot;
+    }
+    w->newest = slot;
+}
+
+// Helper that returns how long a buffer chunk_path() needs, for <dir>/<prefix>-<seed>-<row>-<column> and the null
+// terminator
+static size_t chunk_path_length(const World_T *w) {
+    return strlen(w->dir) + strlen(WORLD_CHUNK_PREFIX) + MAX_SEED_DIGITS + MAX_COORDINATE_DIGITS * 2 + 5;
+}
+
+// Helper that builds the path a chunk is saved at
+static void chunk_path(const World_T *w, int y, int x, char *path) {
+    snprintf(path, chunk_path_length(w), "%s/%s-%" PRIu64 "-%i-%i", w->dir, WORLD_CHUNK_PREFIX, w->seed, y, x);
+}
+
+// Helper that writes a chunk to disk in a single write, the same way save_dungeon() does. Will print an error to stderr
+// if it fails, and the changes are lost.
+static void save_chunk(World_T *w, const Chunk_T *c) {
+    FILE *f;
+    unsigned char *buffer;
+    char *path;
+    size_t size, p;
+    int i;
+
+    path = safe_malloc(chunk_path_length(w));
+    chunk_path(w, c->y, c->x, path);
+    f = fopen(path, "wb");
+    if (f == NULL) {
+        fprintf(stderr, "Couldn't open file %s! Unable to save chunk!\n", path);
+        free(path);
+        return;
+    }
+
+    size = CHUNK_HEADER_SIZE + sizeof(uint16_t) * 4 * c->num_rooms + 2 * CHUNK_CELLS;
+    buffer = safe_malloc(size);
+
+    // Header
+    p = 0;
+    memcpy(&buffer[p], CHUNK_FILE_MARKER, sizeof(CHUNK_FILE_MARKER) - 1);
+    p += sizeof(CHUNK_FILE_MARKER) - 1;
+    write_value(&buffer[p], CHUNK_FILE_VERSION, sizeof(uint32_t));
+    p += sizeof(uint32_t);
+    write_value(&buffer[p], w->seed, sizeof(uint64_t));
+    p += sizeof(uint64_t);
+    write_value(&buffer[p], (uint64_t) c->y, sizeof(uint32_t));
+    write_value(&buffer[p + sizeof(uint32_t)], (uint64_t) c->x, sizeof(uint32_t));
+    p += sizeof(uint32_t) * 2;
+    write_value(&buffer[p], WORLD_CHUNK_HEIGHT, sizeof(uint16_t));
+    write_value(&buffer[p + sizeof(uint16_t)], WORLD_CHUNK_WIDTH, sizeof(uint16_t));
+    write_value(&buffer[p + sizeof(uint16_t) * 2], (uint64_t) c->num_rooms, sizeof(uint16_t));
+    p += sizeof(uint16_t) * 3;
+
+    // Rooms
+    for (i = 0; i < c->num_rooms; i++) {
+        write_value(&buffer[p], (uint64_t) c->rooms[i].y, sizeof(uint16_t));
+        write_value(&buffer[p + sizeof(uint16_t)], (uint64_t) c->rooms[i].x, sizeof(uint16_t));
+        write_value(&buffer[p + sizeof(uint16_t) * 2], (uint64_t) c->rooms[i].height, sizeof(uint16_t));
+        write_value(&buffer[p + sizeof(uint16_t) * 3], (uint64_t) c->rooms[i].width, sizeof(uint16_t));
+        p += sizeof(uint16_t) * 4;
+    }
+
+    // The planes copy straight over
+    memcpy(&buffer[p], c->types, CHUNK_CELLS);
+    p += CHUNK_CELLS;
+    memcpy(&buffer[p], c->hardness, CHUNK_CELLS);
+
+    if (fwrite(buffer, 1, size, f) != size) {
+        fprintf(stderr, "Error writing to %s! Chunk is most likely corrupted!\n", path);
+    }
+    fclose(f);
+    free(buffer);
+    free(path);
+}
+
+// Helper that loads a chunk saved by save_chunk(), returning false if there isn't one. A chunk that was never changed
+// was never saved, so a missing file is expected, but a file that doesn't match what it should be gets a warning before
+// the chunk is generated again over it.
+static bool load_chunk(World_T *w, Chunk_T *c) {
+    FILE *f;
+    unsigned char *buffer;
+    char *path;
+    size_t size, p;
+    int i;
+    bool loaded;
+
+    path = safe_malloc(chunk_path_length(w));
+    chunk_path(w, c->y, c->x, path);
+    f = fopen(path, "rb");
+    if (f == NULL) {
+        free(path);
+        return false;
+    }
+
+    // Read the whole file in at once
+    fseek(f, 0, SEEK_END);
+    size = (size_t) ftell(f);
+    rewind(f);
+    if (size < CHUNK_HEADER_SIZE + 2 * CHUNK_CELLS || size > MAX_CHUNK_FILE_SIZE) {
+        fprintf(stderr, "Chunk %s is %zu bytes, which isn't a chunk! Generating it again!\n", path, size);
+        fclose(f);
+        free(path);
+        return false;
+    }
+    buffer = safe_malloc(size);
+    loaded = fread(buffer, 1, size, f) == size;
+    fclose(f);
+
+    // Check it's the chunk we're after, from this world
+    p = 0;
+    loaded = loaded && memcmp(buffer, CHUNK_FILE_MARKER, sizeof(CHUNK_FILE_MARKER) - 1) == 0;
+    p += sizeof(CHUNK_FILE_MARKER) - 1;
+    loaded = loaded && read_value(&buffer[p], sizeof(uint32_t)) == CHUNK_FILE_VERSION;
+    p += sizeof(uint32_t);
+    loaded = loaded && read_value(&buffer[p], sizeof(uint64_t)) == w->seed;
+    p += sizeof(uint64_t);
+    loaded = loaded && read_value(&buffer[p], sizeof(uint32_t)) == (uint64_t) c->y &&
+             read_value(&buffer[p + sizeof(uint32_t)], sizeof(uint32_t)) == (uint64_t) c->x;
+    p += sizeof(uint32_t) * 2;
+    loaded = loaded && read_value(&buffer[p], sizeof(uint16_t)) == WORLD_CHUNK_HEIGHT &&
+             read_value(&buffer[p + sizeof(uint16_t)], sizeof(uint16_t)) == WORLD_CHUNK_WIDTH;
+    c->num_rooms = (int) read_value(&buffer[p + sizeof(uint16_t) * 2], sizeof(uint16_t));
+    p += sizeof(uint16_t) * 3;
+    loaded = loaded && size == CHUNK_HEADER_SIZE + sizeof(uint16_t) * 4 * c->num_rooms + 2 * CHUNK_CELLS;
+    if (!loaded) {
+        fprintf(stderr, "Chunk %s doesn't match this world! Generating it again!\n", path);
+        c->num_rooms = 0;
+        free(buffer);
+        free(path);
+        return false;
+    }
+
+    // Rooms, making sure each one is inside the border
+    c->rooms = safe_malloc(c->num_rooms * sizeof(Room_T));
+    for (i = 0; i < c->num_rooms; i++) {
+        c->rooms[i].y = (int) read_value(&buffer[p], sizeof(uint16_t));
+        c->rooms[i].x = (int) read_value(&buffer[p + sizeof(uint16_t)], sizeof(uint16_t));
+        c->rooms[i].height = (int) read_value(&buffer[p + sizeof(uint16_t) * 2], sizeof(uint16_t));
+        c->rooms[i].width = (int) read_value(&buffer[p + sizeof(uint16_t) * 3], sizeof(uint16_t));
+        p += sizeof(uint16_t) * 4;
+
+        if (c->rooms[i].y < 1 || c->rooms[i].x < 1 || c->rooms[i].height < 1 || c->rooms[i].width < 1 ||
+            c->rooms[i].y + c->rooms[i].height > WORLD_CHUNK_HEIGHT - 1 ||
+            c->rooms[i].x + c->rooms[i].width > WORLD_CHUNK_WIDTH - 1) {
+            fprintf(stderr, "Chunk %s has a room outside of it! Generating it again!\n", path);
+            free(c->rooms);
+            c->rooms = NULL;
+            c->num_rooms = 0;
+            free(buffer);
+            free(path);
+            return false;
+        }
+    }
+
+    // The planes copy straight over
+    memcpy(c->types, &buffer[p], CHUNK_CELLS);
+    p += CHUNK_CELLS;
+    memcpy(c->hardness, &buffer[p], CHUNK_CELLS);
+
+    free(buffer);
+    free(path);
+    return true;
+}
+
+// Helper that returns where along an edge between two chunks the gate through it is, so both chunks agree on it without
+// either being loaded. Every chunk owns the edge on its south side and the one on its east side. The gate is never on a
+// corner, so it always leads into the inside of both chunks.
+static int gate_offset(const World_T *w, int y, int x, bool south) {
+    uint64_t counter;
+    int length;
+
+    // Each chunk gets three counters: one for generating it, and one for each edge it owns
+    counter = 3 * ((uint64_t) y * (uint64_t) w->num_columns + (uint64_t) x) + (south ? 2 : 1);
+    length = south ? WORLD_CHUNK_WIDTH : WORLD_CHUNK_HEIGHT;
+    return 1 + (int) (random_counter(w->seed, counter) % (uint64_t) (length - 2));
+}
+
+// Helper that opens a gate in the border of a chunk at (gate_y, gate_x), and digs a corridor from the cell inside of it
+// at (y, x) to the middle of the closest room. It goes straight across first and then up or down, like an L, and only
+// turns rock into corridor, so it never cuts through the border or paints over rooms and stairs. Rooms in a chunk are
+// already all connected, so that's all it takes to join the chunk to its neighbor.
+static void dig_gate(Chunk_T *c, int gate_y, int gate_x, int y, int x) {
+    int i, target_y, target_x, best, distance;
+
+    c->CHUNK_TYPE(gate_y, gate_x) = CORRIDOR;
+    c->CHUNK_HARDNESS(gate_y, gate_x) = OPEN_SPACE_HARDNESS;
+
+    // Find the closest room
+    target_y = y;
+    target_x = x;
+    best = -1;
+    for (i = 0; i < c->num_rooms; i++) {
+        distance = manhattan_distance(y, x, c->rooms[i].y + c->rooms[i].height / 2,
+                                      c->rooms[i].x + c->rooms[i].width / 2);
+        if (best == -1 || distance < best) {
+            best = distance;
+            target_y = c->rooms[i].y + c->rooms[i].height / 2;
+            target_x = c->rooms[i].x + c->rooms[i].width / 2;
+        }
+    }
+
+    // Dig across, then up or down, including both ends
+    while (true) {
+        if (c->CHUNK_TYPE(y, x) == ROCK) {
+            c->CHUNK_TYPE(y, x) = CORRIDOR;
+            c->CHUNK_HARDNESS(y, x) = OPEN_SPACE_HARDNESS;
+        }
+        if (x != target_x) {
+            x += x < target_x ? 1 : -1;
+        } else if (y != target_y) {
+            y += y < target_y ? 1 : -1;
+        } else {
+            break;
+        }
+    }
+}
+
+// Helper that turns the immutable border the generator put around a chunk into plain rock, drawing its hardness from
+// the chunk's own generator. Only the sides on the edge of the world stay immutable. Otherwise a window that cuts
+// across chunks could never dig between them, and neither could tunneling monsters.
+static void soften_chunk_border(const World_T *w, Chunk_T *c, Random_T *r) {
+    int i, j;
+
+    for (i = 0; i < WORLD_CHUNK_HEIGHT; i++) {
+        for (j = 0; j < WORLD_CHUNK_WIDTH; j++) {
+            if (i != 0 && i != WORLD_CHUNK_HEIGHT - 1 && j != 0 && j != WORLD_CHUNK_WIDTH - 1) {
+                continue;
+            }
+            if ((i == 0 && c->y == 0) || (i == WORLD_CHUNK_HEIGHT - 1 && c->y == w->num_rows - 1) ||
+                (j == 0 && c->x == 0) || (j == WORLD_CHUNK_WIDTH - 1 && c->x == w->num_columns - 1)) {
+                continue;
+            }
+            c->CHUNK_HARDNESS(i, j) = (uint8_t) random_int_in_range(r, MIN_ROCK_HARDNESS, MAX_ROCK_HARDNESS);
+        }
+    }
+}
+
+// Helper that generates a chunk from the world's seed and where the chunk is. It's a small dungeon of its own, with its
+// border left as a wall of rock between chunks, and a gate dug through each side that has a chunk on the other side of
+// it.
+static void generate_chunk(World_T *w, Chunk_T *c) {
+    Dungeon_T *d;
+    int offset;
+
+    d = generate_default_dungeon(WORLD_CHUNK_HEIGHT, WORLD_CHUNK_WIDTH,
+                                 random_counter(w->seed, 3 * ((uint64_t) c->y * (uint64_t) w->num_columns +
+                                                              (uint64_t) c->x)), NULL);
+    memcpy(c->types, d->types, CHUNK_CELLS);
+    memcpy(c->hardness, d->hardness, CHUNK_CELLS);
+    c->num_rooms = d->num_rooms;
+    c->rooms = safe_malloc(d->num_rooms * sizeof(Room_T));
+    memcpy(c->rooms, d->rooms, d->num_rooms * sizeof(Room_T));
+    soften_chunk_border(w, c, &d->random);
+    cleanup_dungeon(d);
+
+    // North, south, west, then east, skipping the sides on the edge of the world
+    if (c->y > 0) {
+        offset = gate_offset(w, c->y - 1, c->x, true);
+        dig_gate(c, 0, offset, 1, offset);
+    }
+    if (c->y < w->num_rows - 1) {
+        offset = gate_offset(w, c->y, c->x, true);
+        dig_gate(c, WORLD_CHUNK_HEIGHT - 1, offset, WORLD_CHUNK_HEIGHT - 2, offset);
+    }
+    if (c->x > 0) {
+        offset = gate_offset(w, c->y, c->x - 1, false);
+        dig_gate(c, offset, 0, offset, 1);
+    }
+    if (c->x < w->num_columns - 1) {
+        offset = gate_offset(w, c->y, c->x, false);
+        dig_gate(c, offset, WORLD_CHUNK_WIDTH - 1, offset, WORLD_CHUNK_WIDTH - 2);
+    }
+}
+
+// See world.h
+World_T *new_world(const char *dir, uint64_t seed, size_t budget) {
+    World_T *w;
+    int i;
+
+    // Catch settings that can't work at compile time
+    _Static_assert(WORLD_CHUNK_HEIGHT >= MIN_DUNGEON_HEIGHT && WORLD_CHUNK_WIDTH >= MIN_DUNGEON_WIDTH,
+                   "Chunks must be big enough to generate a dungeon in!");
+    _Static_assert(WORLD_HEIGHT % WORLD_CHUNK_HEIGHT == 0 && WORLD_WIDTH % WORLD_CHUNK_WIDTH == 0,
+                   "The world must be a whole number of chunks!");
+
+    w = safe_malloc(sizeof(World_T));
+    w->dir = safe_malloc(strlen(dir) + sizeof("\0"));
+    strcpy(w->dir, dir);
+    w->seed = seed;
+    w->num_rows = WORLD_HEIGHT / WORLD_CHUNK_HEIGHT;
+    w->num_columns = WORLD_WIDTH / WORLD_CHUNK_WIDTH;
+    w->hits = w->generated = w->loaded = w->saved = w->evicted = 0;
+
+    // However many chunks fit in the budget, but always at least one. Planes are allocated as slots get used, so a big
+    // budget doesn't cost anything until it's needed.
+    w->capacity = (int) (budget / (2 * CHUNK_CELLS + sizeof(Chunk_T)));
+    if (w->capacity < 1) {
+        w->capacity = 1;
+    }
+    w->count = 0;
+    w->newest = w->oldest = -1;
+    w->chunks = safe_malloc(w->capacity * sizeof(Chunk_T));
+
+    // Keep the table at most half full
+    w->table_size = 1;
+    while (w->table_size < 2 * w->capacity) {
+        w->table_size *= 2;
+    }
+    w->table = safe_malloc(w->table_size * sizeof(int));
+    for (i = 0; i < w->table_size; i++) {
+        w->table[i] = EMPTY_SLOT;
+    }
+
+    return w;
+}
+
+// See world.h
+Chunk_T *get_world_chunk(World_T *w, int y, int x) {
+    Chunk_T *c;
+    int key, s, slot;
+
+    if (y < 0 || y >= w->num_rows || x < 0 || x >= w->num_columns) {
+        bail(INVALID_STATE, "FATAL ERROR! CHUNK (%i, %i) IS OUTSIDE OF THE WORLD!\n", y, x);
+    }
+
+    // Already cached, so just move it to the front
+    key = y * w->num_columns + x;
+    s = find_slot(w, key);
+    if (w->table[s] != EMPTY_SLOT) {
+        slot = w->table[s];
+        unlink_slot(w, slot);
+        link_slot(w, slot);
+        w->hits++;
+        return &w->chunks[slot];
+    }
+
+    // Take a new slot if there's still room, otherwise throw out the least recently used chunk and reuse its planes
+    if (w->count < w->capacity) {
+        slot = w->count++;
+        w->chunks[slot].types = safe_malloc(CHUNK_CELLS * sizeof(uint8_t));
+        w->chunks[slot].hardness = safe_malloc(CHUNK_CELLS * sizeof(uint8_t));
+    } else {
+        slot = w->oldest;
+        if (w->chunks[slot].dirty) {
+            save_chunk(w, &w->chunks[slot]);
+            w->saved++;
+        }
+        remove_slot(w, chunk_key(w, slot));
+        unlink_slot(w, slot);
+        free(w->chunks[slot].rooms);
+        w->evicted++;
+    }
+
+    // Fill it in, from disk if it was changed before and from the seed if it wasn't
+    c = &w->chunks[slot];
+    c->y = y;
+    c->x = x;
+    c->rooms = NULL;
+    c->num_rooms = 0;
+    c->dirty = false;
+    if (load_chunk(w, c)) {
+        w->loaded++;
+    } else {
+        generate_chunk(w, c);
+        w->generated++;
+    }
+
+    w->table[find_slot(w, key)] = slot;
+    link_slot(w, slot);
+    return c;
+}
+
+// See world.h
+void flush_world(World_T *w) {
+    int i;
+
+    for (i = 0; i < w->count; i++) {
+        if (w->chunks[i].dirty) {
+            save_chunk(w, &w->chunks[i]);
+            w->chunks[i].dirty = false;
+            w->saved++;
+        }
+    }
+}
+
+// See world.h
+void print_world_stats(const World_T *w) {
+    fprintf(stderr, "World: %i of %i chunks cached (%.1f MiB), %lld hits, %lld generated, %lld loaded, %lld saved, "
+                    "%lld evicted\n", w->count, w->capacity,
+            (double) w->count * 2 * CHUNK_CELLS / (1024 * 1024), w->hits, w->generated, w->loaded, w->saved,
+            w->evicted);
+}
+
+// See world.h
+void cleanup_world(World_T *w) {
+    int i;
+
+    flush_world(w);
+    for (i = 0; i < w->count; i++) {
+        free(w->chunks[i].types);
+        free(w->chunks[i].hardness);
+        free(w->chunks[i].rooms);
+    }
+    free(w->chunks);
+    free(w->table);
+    free(w->dir);
+    free(w);
+}
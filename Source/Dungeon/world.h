@@ -0,0 +1,63 @@
+#ifndef ROGUE_WORLD_H
+#define ROGUE_WORLD_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Dungeon/dungeon.h"
+
+// See world.c for helper functions
+
+// Define macros to help obfuscate bare pointer arithmetic, same as TYPE() and HARDNESS() for dungeons
+#define CHUNK_TYPE(a, b) types[(a) * WORLD_CHUNK_WIDTH + (b)]
+#define CHUNK_HARDNESS(a, b) hardness[(a) * WORLD_CHUNK_WIDTH + (b)]
+
+// One WORLD_CHUNK_HEIGHT x WORLD_CHUNK_WIDTH piece of a world, stored as planes the same way a dungeon's map is. y and
+// x are which chunk it is, counted in chunks, and rooms are in the chunk's own coordinates. dirty is set once anything
+// in it changes, so it gets saved before it's thrown out. newer and older link the chunks in the cache from most to
+// least recently used, by slot, with -1 at either end.
+typedef struct Chunk_S {
+    uint8_t *types;
+    uint8_t *hardness;
+    Room_T *rooms;
+    int y, x, num_rooms, newer, older;
+    bool dirty;
+} Chunk_T;
+
+// A world far bigger than a dungeon, WORLD_HEIGHT x WORLD_WIDTH cells, that's never all in memory at once. It's split
+// into chunks, and only the ones that have been asked for recently are kept, in a cache of at most capacity chunks.
+// Every chunk is generated from the seed and where it is, so any chunk can be built on its own in any order and always
+// comes out the same, without touching its neighbors. Chunks that were changed are saved to dir when they're thrown
+// out, and loaded back instead of being generated the next time they're needed.
+//
+// table maps which chunk (row * num_columns + column) is in which slot, with open addressing like the occupancy table,
+// and is sized to never be more than half full. The counts are kept for print_world_stats().
+typedef struct World_S {
+    Chunk_T *chunks;
+    int *table;
+    char *dir;
+    uint64_t seed;
+    int num_rows, num_columns, capacity, count, table_size, newest, oldest;
+    long long hits, generated, loaded, saved, evicted;
+} World_T;
+
+// Returns a new empty world, keeping at most budget bytes of chunks in memory, and saving changed chunks in dir, which
+// has to already exist. Chunks saved from a different seed are never loaded.
+World_T *new_world(const char *dir, uint64_t seed, size_t budget);
+
+// Returns chunk (y, x) in chunks, loading or generating it if it isn't cached, and marking it most recently used. The
+// pointer is only good until the next call, since that might throw this chunk out to make room. Set dirty on it if
+// it gets changed.
+Chunk_T *get_world_chunk(World_T *w, int y, int x);
+
+// Saves every changed chunk still in memory to disk
+void flush_world(World_T *w);
+
+// Prints how many chunks were generated, loaded, saved and thrown out to stderr
+void print_world_stats(const World_T *w);
+
+// Saves every changed chunk and frees the world
+void cleanup_world(World_T *w);
+
+#endif //ROGUE_WORLD_H
@@ -37,24 +37,6 @@ void *safe_realloc(void *old_ptr, size_t size) {
     return p;
 }
 
-// See helpers.h
-int rand_int_in_range(int lower, int upper) {
-    return rand() % (upper - lower + 1) + lower; // NOLINT(cert-msc50-cpp)
-}
-
-// See helpers.h
-void shuffle_int_array(int *arr, int n) {
-    int i, swap, temp;
-
-    // Start at the last element, pick a random element, and swap them
-    for (i = n - 1; i > 0; i--) {
-        swap = rand_int_in_range(0, i);
-        temp = arr[i];
-        arr[i] = arr[swap];
-        arr[swap] = temp;
-    }
-}
-
 // See helpers.h
 int count_digits(int n) {
     int c;
@@ -82,6 +64,29 @@ int manhattan_distance(int y0, int x0, int y1, int x1) {
 }
 
 
+// See helpers.h
+uint64_t read_value(const unsigned char *buffer, int bytes) {
+    uint64_t value;
+    int i;
+
+    value = 0;
+    for (i = 0; i < bytes; i++) {
+        value = value << 8 | buffer[i];
+    }
+
+    return value;
+}
+
+// See helpers.h
+void write_value(unsigned char *buffer, uint64_t value, int bytes) {
+    int i;
+
+    for (i = bytes - 1; i >= 0; i--) {
+        buffer[i] = (unsigned char) value;
+        value >>= 8;
+    }
+}
+
 // See helpers.h
 void bail(int code, char *msg, ...) {
     va_list args;
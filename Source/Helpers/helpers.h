@@ -1,34 +1,72 @@
 #ifndef ROGUE_HELPERS_H
 #define ROGUE_HELPERS_H
 
+#include <stddef.h>
+#include <stdint.h>
+
+// Defines the palette of colors we can print to the console with, as X(name, red, green, blue). Every entry becomes a
+// COLOR_<name> in Color_T below, and the escape codes for each are built off of the RGB values in output.c. To add a
+// new color, just add a line here.
+#define PALETTE(X) \
+    X(WHITE, 255, 255, 255) \
+    X(GREY, 127, 127, 127) \
+    X(BLACK, 0, 0, 0) \
+    X(SILVER, 170, 170, 170) \
+    X(KHAKI, 240, 230, 140) \
+    X(BROWN, 139, 69, 19) \
+    X(LIME_GREEN, 50, 205, 50) \
+    X(COBALT, 70, 130, 180) \
+    X(TEAL, 0, 128, 128) \
+    X(SKY_BLUE, 135, 206, 235) \
+    X(BRICK, 178, 34, 34) \
+    X(SLATE_BLUE, 106, 90, 205) \
+    X(RED, 255, 0, 0) \
+    X(ORANGE, 255, 165, 0) \
+    X(YELLOW, 255, 255, 0) \
+    X(GREEN, 0, 128, 0) \
+    X(BLUE, 65, 105, 225) \
+    X(PURPLE, 138, 43, 226) \
+    X(PINK, 238, 130, 238)
+
+// Enum of every color in the palette. NO_COLOR means the terminal's default color.
+#define PALETTE_ENUM(name, red, green, blue) COLOR_##name,
+typedef enum Color_E {
+    NO_COLOR = -1, PALETTE(PALETTE_ENUM) NUM_COLORS
+} Color_T;
+#undef PALETTE_ENUM
+
 // Defines colors for printing to console
-#define BACKGROUND_WHITE "\x1b[48;2;255;255;255m"
-#define BACKGROUND_GREY "\x1b[48;2;127;127;127m"
-#define BACKGROUND_BLACK "\x1b[48;2;0;0;0m"
-
-#define FOREGROUND_WHITE "\x1b[38;2;255;255;255m"
-#define FOREGROUND_GREY "\x1b[38;2;170;170;170m"
-#define FOREGROUND_KHAKI "\x1b[38;2;240;230;140m"
-#define FOREGROUND_BROWN "\x1b[38;2;139;69;19m"
-
-#define FOREGROUND_LIME_GREEN "\x1b[38;2;50;205;50m"
-#define FOREGROUND_COBALT "\x1b[38;2;70;130;180m"
-#define FOREGROUND_TEAL "\x1b[38;2;0;128;128m"
-#define FOREGROUND_SKY_BLUE "\x1b[38;2;135;206;235m"
-#define FOREGROUND_BRICK "\x1b[38;2;178;34;34m"
-#define FOREGROUND_SLATE_BLUE "\x1b[38;2;106;90;205m"
-
-#define FOREGROUND_RED "\x1b[38;2;255;0;0m"
-#define FOREGROUND_ORANGE "\x1b[38;2;255;165;0m"
-#define FOREGROUND_YELLOW "\x1b[38;2;255;255;0m"
-#define FOREGROUND_GREEN "\x1b[38;2;0;128;0m"
-#define FOREGROUND_BLUE "\x1b[38;2;65;105;225m"
-#define FOREGROUND_PURPLE "\x1b[38;2;138;43;226m"
-#define FOREGROUND_PINK "\x1b[38;2;238;130;238m"
+#define BACKGROUND_WHITE COLOR_WHITE
+#define BACKGROUND_GREY COLOR_GREY
+#define BACKGROUND_BLACK COLOR_BLACK
+
+#define FOREGROUND_WHITE COLOR_WHITE
+#define FOREGROUND_GREY COLOR_SILVER
+#define FOREGROUND_KHAKI COLOR_KHAKI
+#define FOREGROUND_BROWN COLOR_BROWN
+
+#define FOREGROUND_LIME_GREEN COLOR_LIME_GREEN
+#define FOREGROUND_COBALT COLOR_COBALT
+#define FOREGROUND_TEAL COLOR_TEAL
+#define FOREGROUND_SKY_BLUE COLOR_SKY_BLUE
+#define FOREGROUND_BRICK COLOR_BRICK
+#define FOREGROUND_SLATE_BLUE COLOR_SLATE_BLUE
+
+#define FOREGROUND_RED COLOR_RED
+#define FOREGROUND_ORANGE COLOR_ORANGE
+#define FOREGROUND_YELLOW COLOR_YELLOW
+#define FOREGROUND_GREEN COLOR_GREEN
+#define FOREGROUND_BLUE COLOR_BLUE
+#define FOREGROUND_PURPLE COLOR_PURPLE
+#define FOREGROUND_PINK COLOR_PINK
 
 // Defines the proper key combo to reset the console
 #define CONSOLE_RESET "\x1b[0m"
 
+// Defines the key combos to clear the console, and to move the cursor back to the top left corner
+#define CONSOLE_CLEAR "\x1b[2J"
+#define CONSOLE_HOME "\x1b[H"
+
 // Wraps malloc() with an additional check to make sure the pointer is real. If it's not the program kills.
 void *safe_malloc(size_t size);
 
@@ -38,19 +76,19 @@ void *safe_calloc(size_t num, size_t size);
 // Same as safe_malloc()
 void *safe_realloc(void *ptr, size_t size);
 
-// Returns a random integer in the range [lower, upper] (inclusive). LOWER MUST BE < UPPER OR AN ARITHMETIC FAULT
-// WILL BE GENERATED
-int rand_int_in_range(int lower, int upper);
-
-// Shuffles the given int array with a Fisher-Yates algorithm. Modifies the array in memory.
-void shuffle_int_array(int *arr, int n);
-
 // Returns the number of digits in a given integer (used for printing)
 int count_digits(int n);
 
 // Calculates the Manhattan distance between two points
 int manhattan_distance(int y0, int x0, int y1, int x1);
 
+// Reads a big-endian unsigned value that's bytes long (up to 8) out of a buffer, which doesn't have to be aligned.
+// Files store values in different widths, so this keeps the loaders from caring which.
+uint64_t read_value(const unsigned char *buffer, int bytes);
+
+// Writes a big-endian unsigned value that's bytes long (up to 8) into a buffer. Opposite of read_value().
+void write_value(unsigned char *buffer, uint64_t value, int bytes);
+
 // Wrapper to kill the program while informing the user as to why. MSG MUST BE PROPERLY FORMATTED FOR FPRINT OR WE WILL
 // CAUSE A SEGFAULT AND CRASH
 _Noreturn void bail(int code, char *msg, ...);
@@ -0,0 +1,107 @@
+// We have to include this macro so gcc shuts up and will actually compile
+// I think this is what I get for wanting to compile against C11
+#define _POSIX_C_SOURCE 200809L // NOLINT(bugprone-reserved-identifier)
+
+#include <stdio.h>
+#include <math.h>
+#include <errno.h>
+#include <limits.h>
+
+#include "pacer.h"
+
+// See pacer.h
+long long time_difference(const struct timespec *a, const struct timespec *b) {
+    return (a->tv_sec - b->tv_sec) * NANOSECONDS + (a->tv_nsec - b->tv_nsec);
+}
+
+// Helper that pushes a time forward by some number of nanoseconds, keeping it normalized
+static void time_advance(struct timespec *t, long long nanoseconds) {
+    nanoseconds += t->tv_nsec;
+    t->tv_sec += (time_t) (nanoseconds / NANOSECONDS);
+    t->tv_nsec = (long) (nanoseconds % NANOSECONDS);
+}
+
+// See pacer.h
+void init_pacer(Pacer_T *p, int fps) {
+    clock_gettime(CLOCK_MONOTONIC, &p->start);
+    p->deadline = p->start;
+    p->last = p->start;
+    p->period = NANOSECONDS / fps;
+    p->frames = 0;
+    p->skipped = 0;
+    p->late_min = LLONG_MAX;
+    p->late_max = 0;
+    p->late_sum = 0;
+    p->late_squared_sum = 0;
+}
+
+// Helper that sleeps until the pacer's deadline, and keeps track of how late we woke up
+static void pacer_sleep(Pacer_T *p) {
+    long long late;
+
+    // Sleep until the deadline. Have to loop since a signal can wake us up early.
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &p->deadline, NULL) == EINTR);
+
+    // Keep track of how late we woke up
+    clock_gettime(CLOCK_MONOTONIC, &p->last);
+    late = time_difference(&p->last, &p->deadline);
+    late = late < 0 ? 0 : late;
+    p->late_min = late < p->late_min ? late : p->late_min;
+    p->late_max = late > p->late_max ? late : p->late_max;
+    p->late_sum += (double) late;
+    p->late_squared_sum += (double) late * (double) late;
+    p->frames++;
+}
+
+// See pacer.h
+int pacer_wait(Pacer_T *p) {
+    struct timespec now;
+    long long behind;
+    int skipped;
+
+    // Our next deadline is always exactly one period after the last one, no matter how long the frame took
+    time_advance(&p->deadline, p->period);
+
+    // If we've already blown through more than one whole frame, skip the frames we missed instead of trying to catch
+    // up on them all at once
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    behind = time_difference(&now, &p->deadline);
+    skipped = 0;
+    if (behind > p->period) {
+        skipped = (int) (behind / p->period);
+        time_advance(&p->deadline, skipped * p->period);
+        p->skipped += skipped;
+    }
+
+    pacer_sleep(p);
+
+    return skipped;
+}
+
+// See pacer.h
+void pacer_wait_until(Pacer_T *p, long long offset) {
+    p->deadline = p->start;
+    time_advance(&p->deadline, offset);
+    pacer_sleep(p);
+}
+
+// See pacer.h
+void print_pacer_stats(const Pacer_T *p, const char *name) {
+    double elapsed, mean, deviation;
+
+    // Nothing to report if we never waited
+    if (p->frames == 0) {
+        fprintf(stderr, "%s: no frames paced\n", name);
+        return;
+    }
+
+    // Work out our stats... elapsed is in seconds, and jitter is reported in microseconds
+    elapsed = (double) time_difference(&p->last, &p->start) / NANOSECONDS;
+    mean = p->late_sum / (double) p->frames;
+    deviation = sqrt(fmax(p->late_squared_sum / (double) p->frames - mean * mean, 0));
+
+    fprintf(stderr, "%s: %lld frames in %.3fs (%.2f FPS, target %.2f), %lld skipped\n", name, p->frames, elapsed,
+            elapsed > 0 ? (double) p->frames / elapsed : 0, (double) NANOSECONDS / (double) p->period, p->skipped);
+    fprintf(stderr, "%s: wake up jitter %.1fus mean, %.1fus std dev, %.1fus min, %.1fus max\n", name, mean / 1000,
+            deviation / 1000, (double) p->late_min / 1000, (double) p->late_max / 1000);
+}
@@ -0,0 +1,36 @@
+#ifndef ROGUE_PACER_H
+#define ROGUE_PACER_H
+
+#include <time.h>
+
+// Number of nanoseconds in a second... makes arithmetic on times easier to read
+#define NANOSECONDS 1000000000LL
+
+// A pacer keeps a loop running at a fixed rate by sleeping until absolute deadlines on the monotonic clock, instead of
+// sleeping a fixed amount after the work is done. Time spent doing the work is absorbed into the frame, so the rate
+// doesn't drift. If the loop falls more than a whole frame behind, the missed frames are skipped rather than bursted
+// through to catch up. Every wake up is measured against its deadline, so we can report how well we kept time.
+typedef struct Pacer_S {
+    struct timespec start, deadline, last;
+    long long period, frames, skipped;
+    long long late_min, late_max;
+    double late_sum, late_squared_sum;
+} Pacer_T;
+
+// Returns how many nanoseconds after b a is. Divide by NANOSECONDS for seconds.
+long long time_difference(const struct timespec *a, const struct timespec *b);
+
+// Initializes a pacer to run at fps frames per second, starting now
+void init_pacer(Pacer_T *p, int fps);
+
+// Sleeps until the next frame's deadline. Returns how many frames were skipped because the caller fell behind.
+int pacer_wait(Pacer_T *p);
+
+// Sleeps until offset nanoseconds after the pacer was started, for loops that follow a timeline instead of a fixed
+// rate. Returns right away if that time has already passed.
+void pacer_wait_until(Pacer_T *p, long long offset);
+
+// Prints the achieved frame rate, skipped frames and wake up jitter to stderr, labelled with name
+void print_pacer_stats(const Pacer_T *p, const char *name);
+
+#endif //ROGUE_PACER_H
@@ -1,6 +1,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <time.h>
+#include <unistd.h>
 #include <string.h>
 
 // Check if we are on Windows or *nix to include the correct director to make directories
@@ -13,11 +14,14 @@
 #include "program-init.h"
 #include "helpers.h"
 
+#include "Render/glyph.h"
 #include "Settings/arguments.h"
 #include "Settings/character-settings.h"
+#include "Settings/dungeon-settings.h"
 #include "Settings/exit-codes.h"
 #include "Settings/file-settings.h"
 #include "Settings/misc-settings.h"
+#include "Settings/print-settings.h"
 
 // Struct to store all our arguments to pass between read_arguments() and init_program()
 typedef struct Arguments_S {
@@ -28,14 +32,39 @@ typedef struct Arguments_S {
     bool stairs;
     bool seed;
     bool nummon;
+    bool height;
+    bool width;
     bool print;
+    bool color;
+    bool record_frames;
+    bool play_frames;
+    bool play_speed;
+    bool generate;
+    bool out_dir;
+    bool threads;
+    bool gen_stats;
+    bool world;
+    bool world_at;
     bool help;
     bool version;
     char *load_path;
     char *save_dungeon_path;
     char *save_pgm_path;
-    unsigned int rand_seed;
+    char *record_path;
+    char *play_path;
+    char *generate_dir;
+    char *world_dir;
+    unsigned long long rand_seed;
     int num_monsters;
+    int dungeon_height;
+    int dungeon_width;
+    int num_generate;
+    int num_threads;
+    int num_gen_stats;
+    int world_y;
+    int world_x;
+    Color_Mode_T color_mode;
+    double speed;
 } Arguments_T;
 
 // Helper for read_arguments that checks if the string is an actual argument for the program.
@@ -63,9 +92,46 @@ static bool is_argument_string(const char *s) {
     if (strcmp(s, NUMMON_LONG) == 0 || strcmp(s, NUMMON_SHORT) == 0) {
         return true;
     }
+    if (strcmp(s, HEIGHT_LONG) == 0 || strcmp(s, HEIGHT_SHORT) == 0) {
+        return true;
+    }
+    if (strcmp(s, WIDTH_LONG) == 0 || strcmp(s, WIDTH_SHORT) == 0) {
+        return true;
+    }
     if (strcmp(s, PRINT_LONG) == 0 || strcmp(s, PRINT_SHORT) == 0) {
         return true;
     }
+    if (strcmp(s, COLOR_LONG) == 0 || strcmp(s, COLOR_SHORT) == 0 ||
+        strncmp(s, COLOR_LONG "=", sizeof(COLOR_LONG "=") - 1) == 0) {
+        return true;
+    }
+    if (strcmp(s, RECORD_FRAMES_LONG) == 0 || strcmp(s, RECORD_FRAMES_SHORT) == 0) {
+        return true;
+    }
+    if (strcmp(s, PLAY_FRAMES_LONG) == 0 || strcmp(s, PLAY_FRAMES_SHORT) == 0) {
+        return true;
+    }
+    if (strcmp(s, PLAY_SPEED_LONG) == 0 || strcmp(s, PLAY_SPEED_SHORT) == 0) {
+        return true;
+    }
+    if (strcmp(s, GENERATE_LONG) == 0 || strcmp(s, GENERATE_SHORT) == 0) {
+        return true;
+    }
+    if (strcmp(s, OUT_DIR_LONG) == 0 || strcmp(s, OUT_DIR_SHORT) == 0) {
+        return true;
+    }
+    if (strcmp(s, THREADS_LONG) == 0 || strcmp(s, THREADS_SHORT) == 0) {
+        return true;
+    }
+    if (strcmp(s, GEN_STATS_LONG) == 0 || strcmp(s, GEN_STATS_SHORT) == 0) {
+        return true;
+    }
+    if (strcmp(s, WORLD_LONG) == 0 || strcmp(s, WORLD_SHORT) == 0) {
+        return true;
+    }
+    if (strcmp(s, WORLD_AT_LONG) == 0 || strcmp(s, WORLD_AT_SHORT) == 0) {
+        return true;
+    }
     if (strcmp(s, HELP_LONG) == 0 || strcmp(s, HELP_SHORT) == 0) {
         return true;
     }
@@ -202,8 +268,9 @@ static void read_arguments(int argc, const char *argv[], Arguments_T *a) {
             if (i < argc && !is_argument_string(argv[i])) {
                 char *end;
 
-                // strtol is safer than atil()... we can check if it's an int and if it actually worked
-                a->rand_seed = (unsigned int) strtol(argv[i], &end, 0);
+                // strtoull is safer than atoi()... we can check if it's an int and if it actually worked. Seeds are
+                // 64 bits, so take the whole thing.
+                a->rand_seed = strtoull(argv[i], &end, 0);
                 if (end == NULL || *end != (char) 0) {
                     bail(INVALID_ARGUMENT, "Invalid seed %s! Seed must be in integer!\n", argv[i]);
                 }
@@ -245,6 +312,64 @@ static void read_arguments(int argc, const char *argv[], Arguments_T *a) {
             continue;
         }
 
+        // Check for the height flag
+        if (strcmp(argv[i], HEIGHT_LONG) == 0 || strcmp(argv[i], HEIGHT_SHORT) == 0) {
+
+            // Check if it's been used
+            if (a->height) {
+                bail(INVALID_ARGUMENT, "Height option already specified!\n");
+            }
+            a->height = true;
+            i++;
+
+            // Find if there is an argument to height and bail if there isn't
+            if (i < argc && !is_argument_string(argv[i])) {
+                char *end;
+
+                a->dungeon_height = (int) strtol(argv[i], &end, 0);
+                if (end == NULL || *end != (char) 0 || a->dungeon_height < MIN_DUNGEON_HEIGHT ||
+                    a->dungeon_height > MAX_DUNGEON_HEIGHT) {
+                    bail(INVALID_ARGUMENT, "Invalid height %s! Height must be an integer from %i to %i!\n", argv[i],
+                         MIN_DUNGEON_HEIGHT, MAX_DUNGEON_HEIGHT);
+                }
+                i++;
+
+            } else {
+                bail(INVALID_ARGUMENT, "Height option must have an integer argument!\n");
+            }
+
+            continue;
+        }
+
+        // Check for the width flag
+        if (strcmp(argv[i], WIDTH_LONG) == 0 || strcmp(argv[i], WIDTH_SHORT) == 0) {
+
+            // Check if it's been used
+            if (a->width) {
+                bail(INVALID_ARGUMENT, "Width option already specified!\n");
+            }
+            a->width = true;
+            i++;
+
+            // Find if there is an argument to width and bail if there isn't
+            if (i < argc && !is_argument_string(argv[i])) {
+                char *end;
+
+                a->dungeon_width = (int) strtol(argv[i], &end, 0);
+                if (end == NULL || *end != (char) 0 || a->dungeon_width < MIN_DUNGEON_WIDTH ||
+                    a->dungeon_width > MAX_DUNGEON_WIDTH) {
+                    bail(INVALID_ARGUMENT, "Invalid width %s! Width must be an integer from %i to %i!\n", argv[i],
+                         MIN_DUNGEON_WIDTH, MAX_DUNGEON_WIDTH);
+                }
+                i++;
+
+            } else {
+                bail(INVALID_ARGUMENT, "Width option must have an integer argument!\n");
+            }
+
+            continue;
+        }
+
         // Check for the help flag
         if (strcmp(argv[i], PRINT_LONG) == 0 || strcmp(argv[i], PRINT_SHORT) == 0) {
 
@@ -258,6 +383,259 @@ static void read_arguments(int argc, const char *argv[], Arguments_T *a) {
             continue;
         }
 
+        // Check for the color flag, which can have its mode attached with an = or be followed by it
+        if (strcmp(argv[i], COLOR_LONG) == 0 || strcmp(argv[i], COLOR_SHORT) == 0 ||
+            strncmp(argv[i], COLOR_LONG "=", sizeof(COLOR_LONG "=") - 1) == 0) {
+            const char *mode;
+
+            // Check if it's been used
+            if (a->color) {
+                bail(INVALID_ARGUMENT, "Color option already specified!\n");
+            }
+            a->color = true;
+
+            // Find the mode and bail if there isn't one
+            if (strncmp(argv[i], COLOR_LONG "=", sizeof(COLOR_LONG "=") - 1) == 0) {
+                mode = &argv[i][sizeof(COLOR_LONG "=") - 1];
+            } else if (i + 1 < argc && !is_argument_string(argv[i + 1])) {
+                i++;
+                mode = argv[i];
+            } else {
+                bail(INVALID_ARGUMENT, "Color option must have a mode argument!\n");
+            }
+            i++;
+
+            if (!parse_color_mode(mode, &a->color_mode)) {
+                bail(INVALID_ARGUMENT, "Invalid color mode %s! Must be truecolor, 256, 16 or none!\n", mode);
+            }
+
+            continue;
+        }
+
+        // Check for the record frames flag
+        if (strcmp(argv[i], RECORD_FRAMES_LONG) == 0 || strcmp(argv[i], RECORD_FRAMES_SHORT) == 0) {
+
+            // Check if it's been used
+            if (a->record_frames) {
+                bail(INVALID_ARGUMENT, "Record frames option already specified!\n");
+            }
+            a->record_frames = true;
+            i++;
+
+            // There's no default recording, so bail if there isn't a path
+            if (i < argc && !is_argument_string(argv[i])) {
+                a->record_path = safe_malloc(strlen(argv[i]) + sizeof("\0")); // allocate space for null terminator
+                strcpy(a->record_path, argv[i]);
+                i++;
+            } else {
+                bail(INVALID_ARGUMENT, "Record frames option must have a file argument!\n");
+            }
+            continue;
+        }
+
+        // Check for the play frames flag
+        if (strcmp(argv[i], PLAY_FRAMES_LONG) == 0 || strcmp(argv[i], PLAY_FRAMES_SHORT) == 0) {
+
+            // Check if it's been used
+            if (a->play_frames) {
+                bail(INVALID_ARGUMENT, "Play frames option already specified!\n");
+            }
+            a->play_frames = true;
+            i++;
+
+            // There's no default recording, so bail if there isn't a path
+            if (i < argc && !is_argument_string(argv[i])) {
+                a->play_path = safe_malloc(strlen(argv[i]) + sizeof("\0")); // allocate space for null terminator
+                strcpy(a->play_path, argv[i]);
+                i++;
+            } else {
+                bail(INVALID_ARGUMENT, "Play frames option must have a file argument!\n");
+            }
+            continue;
+        }
+
+        // Check for the play speed flag
+        if (strcmp(argv[i], PLAY_SPEED_LONG) == 0 || strcmp(argv[i], PLAY_SPEED_SHORT) == 0) {
+
+            // Check if it's been used
+            if (a->play_speed) {
+                bail(INVALID_ARGUMENT, "Play speed option already specified!\n");
+            }
+            a->play_speed = true;
+            i++;
+
+            // Find if there is an argument to speed and bail if there isn't
+            if (i < argc && !is_argument_string(argv[i])) {
+                char *end;
+
+                a->speed = strtod(argv[i], &end);
+                if (end == NULL || *end != (char) 0 || !(a->speed > 0)) {
+                    bail(INVALID_ARGUMENT, "Invalid speed %s! Speed must be a number greater than 0!\n", argv[i]);
+                }
+                i++;
+
+            } else {
+                bail(INVALID_ARGUMENT, "Play speed option must have a number argument!\n");
+            }
+
+            continue;
+        }
+
+        // Check for the generate flag
+        if (strcmp(argv[i], GENERATE_LONG) == 0 || strcmp(argv[i], GENERATE_SHORT) == 0) {
+
+            // Check if it's been used
+            if (a->generate) {
+                bail(INVALID_ARGUMENT, "Generate option already specified!\n");
+            }
+            a->generate = true;
+            i++;
+
+            // Find if there is an argument to count and bail if there isn't
+            if (i < argc && !is_argument_string(argv[i])) {
+                char *end;
+
+                a->num_generate = (int) strtol(argv[i], &end, 0);
+                if (end == NULL || *end != (char) 0 || a->num_generate < 1) {
+                    bail(INVALID_ARGUMENT,
+                         "Invalid integer %s! Number of dungeons must be an integer and greater than 0!\n", argv[i]);
+                }
+                i++;
+
+            } else {
+                bail(INVALID_ARGUMENT, "Generate option must have an integer argument!\n");
+            }
+
+            continue;
+        }
+
+        // Check for the out dir flag
+        if (strcmp(argv[i], OUT_DIR_LONG) == 0 || strcmp(argv[i], OUT_DIR_SHORT) == 0) {
+
+            // Check if it's been used
+            if (a->out_dir) {
+                bail(INVALID_ARGUMENT, "Out dir option already specified!\n");
+            }
+            a->out_dir = true;
+            i++;
+
+            // Bail if there isn't a directory, since the default is what not using the option gives
+            if (i < argc && !is_argument_string(argv[i])) {
+                a->generate_dir = safe_malloc(strlen(argv[i]) + sizeof("\0")); // allocate space for null terminator
+                strcpy(a->generate_dir, argv[i]);
+                i++;
+            } else {
+                bail(INVALID_ARGUMENT, "Out dir option must have a directory argument!\n");
+            }
+            continue;
+        }
+
+        // Check for the threads flag
+        if (strcmp(argv[i], THREADS_LONG) == 0 || strcmp(argv[i], THREADS_SHORT) == 0) {
+
+            // Check if it's been used
+            if (a->threads) {
+                bail(INVALID_ARGUMENT, "Threads option already specified!\n");
+            }
+            a->threads = true;
+            i++;
+
+            // Find if there is an argument to count and bail if there isn't
+            if (i < argc && !is_argument_string(argv[i])) {
+                char *end;
+
+                a->num_threads = (int) strtol(argv[i], &end, 0);
+                if (end == NULL || *end != (char) 0 || a->num_threads < 1) {
+                    bail(INVALID_ARGUMENT,
+                         "Invalid integer %s! Number of threads must be an integer and greater than 0!\n", argv[i]);
+                }
+                i++;
+
+            } else {
+                bail(INVALID_ARGUMENT, "Threads option must have an integer argument!\n");
+            }
+
+            continue;
+        }
+
+        // Check for the gen stats flag
+        if (strcmp(argv[i], GEN_STATS_LONG) == 0 || strcmp(argv[i], GEN_STATS_SHORT) == 0) {
+
+            // Check if it's been used
+            if (a->gen_stats) {
+                bail(INVALID_ARGUMENT, "Gen stats option already specified!\n");
+            }
+            a->gen_stats = true;
+            i++;
+
+            // Find if there is an argument to count and bail if there isn't
+            if (i < argc && !is_argument_string(argv[i])) {
+                char *end;
+
+                a->num_gen_stats = (int) strtol(argv[i], &end, 0);
+                if (end == NULL || *end != (char) 0 || a->num_gen_stats < 1) {
+                    bail(INVALID_ARGUMENT,
+                         "Invalid integer %s! Number of dungeons must be an integer and greater than 0!\n", argv[i]);
+                }
+                i++;
+
+            } else {
+                bail(INVALID_ARGUMENT, "Gen stats option must have an integer argument!\n");
+            }
+
+            continue;
+        }
+
+        // Check for the world flag
+        if (strcmp(argv[i], WORLD_LONG) == 0 || strcmp(argv[i], WORLD_SHORT) == 0) {
+
+            // Check if it's been used
+            if (a->world) {
+                bail(INVALID_ARGUMENT, "World option already specified!\n");
+            }
+            a->world = true;
+            i++;
+
+            // Check if there is a directory specified
+            if (i < argc && !is_argument_string(argv[i])) {
+                a->world_dir = safe_malloc(strlen(argv[i]) + sizeof("\0")); // allocate space for null terminator
+                strcpy(a->world_dir, argv[i]);
+                i++;
+            }
+            continue;
+        }
+
+        // Check for the world at flag
+        if (strcmp(argv[i], WORLD_AT_LONG) == 0 || strcmp(argv[i], WORLD_AT_SHORT) == 0) {
+
+            // Check if it's been used
+            if (a->world_at) {
+                bail(INVALID_ARGUMENT, "World at option already specified!\n");
+            }
+            a->world_at = true;
+            i++;
+
+            // Find if there is a row and column and bail if there isn't
+            if (i < argc && !is_argument_string(argv[i])) {
+                char *end;
+
+                a->world_y = (int) strtol(argv[i], &end, 0);
+                if (end == NULL || *end != ',' || a->world_y < 0) {
+                    bail(INVALID_ARGUMENT, "Invalid position %s! Position must be <row>,<column>!\n", argv[i]);
+                }
+                a->world_x = (int) strtol(end + 1, &end, 0);
+                if (end == NULL || *end != (char) 0 || a->world_x < 0) {
+                    bail(INVALID_ARGUMENT, "Invalid position %s! Position must be <row>,<column>!\n", argv[i]);
+                }
+                i++;
+
+            } else {
+                bail(INVALID_ARGUMENT, "World at option must have a <row>,<column> argument!\n");
+            }
+
+            continue;
+        }
+
         // Check for the help flag
         if (strcmp(argv[i], HELP_LONG) == 0 || strcmp(argv[i], HELP_SHORT) == 0) {
 
@@ -302,12 +680,42 @@ static void print_help() {
     printf("--stairs causes stairs to be guaranteed to placed. Mostly useful for --pgm-load\n");
     printf("--seed <seed> will specify a seed for the RNG. MUST BE AN INTEGER!\n");
     printf("--nummons <num> will specific the number of monsters to spawn. MUST BE AN INTEGER!\n");
+    printf("--height <num> and --width <num> set the size of random dungeons, border included. Default is %ix%i.\n",
+           DUNGEON_WIDTH, DUNGEON_HEIGHT);
+    printf("     Each can be from %i to %i and %i to %i. Room counts scale with the area.\n", MIN_DUNGEON_HEIGHT,
+           MAX_DUNGEON_HEIGHT, MIN_DUNGEON_WIDTH, MAX_DUNGEON_WIDTH);
     printf("--print or -p causes the dungeon and cost maps to be printed out, instead of the game playing.\n");
+    printf("--color <mode> or --color=<mode> sets how colors are sent to the terminal.\n");
+    printf("     truecolor is exact, 256 and 16 use the closest color the terminal has and much less output,\n");
+    printf("     and none turns colors off. Default is truecolor.\n");
+    printf("--record-frames <file> records every frame of the game to a file, to be watched later.\n");
+    printf("--play-frames <file> plays back a recording instead of playing the game.\n");
+    printf("--play-speed <num> plays back a recording that many times faster. 0.5 is half speed. Default is %g.\n",
+           DEFAULT_PLAY_SPEED);
+    printf("--generate <num> generates that many dungeons off of consecutive seeds and saves them, "
+           "instead of playing.\n");
+    printf("     Each is saved as %s-<seed> and %s-<seed>%s. Starts at --seed if it's given.\n",
+           GENERATE_FILE_PREFIX, GENERATE_FILE_PREFIX, GENERATE_PGM_EXTENSION);
+    printf("--out-dir <dir> is where --generate saves dungeons. Default is %s.\n", DEFAULT_GENERATE_DIRECTORY);
+    printf("--threads <num> is how many threads --generate uses. Default is one per core.\n");
+    printf("--gen-stats <num> generates that many dungeons without saving them, "
+           "and prints how many attempts each took,\n");
+    printf("     how long each phase of generation took, and how many rooms and how much coverage came out.\n");
+    printf("     Starts at --seed if it's given, and uses --height and --width.\n");
+    printf("--world plays in a window of a %ix%i world, instead of a dungeon of its own. The world is built in\n",
+           WORLD_WIDTH, WORLD_HEIGHT);
+    printf("     %ix%i chunks as they're needed, and the same --seed always builds the same world. Chunks that\n",
+           WORLD_CHUNK_WIDTH, WORLD_CHUNK_HEIGHT);
+    printf("     change are saved, so the next game there picks up where the last left off.\n");
+    printf("     <dir> after will mean chunks are saved there instead of the default.\n");
+    printf("--world-at <row>,<column> is where the top left corner of the --world window is. Default is 0,0.\n");
+    printf("     The window is --height x --width, and has to fit inside the world.\n");
     printf("--version will print the version of the program.\n");
     printf("--help will print this.\n");
     printf("\n");
     printf("Default dungeon path is: $HOME%s%s\n", SAVE_PATH, DEFAULT_DUNGEON_NAME);
     printf("Default PGM path is: $HOME%s%s\n", SAVE_PATH, DEFAULT_PGM_NAME);
+    printf("Default world path is: $HOME%s%s\n", SAVE_PATH, DEFAULT_WORLD_DIRECTORY);
     printf("\n");
     printf("PGM files must be binary, with max value of %i. Values of %i are corridors\n", PGM_MAX_VAL,
            PGM_CORRIDOR_VAL);
@@ -332,7 +740,12 @@ void init_program(int argc, const char *argv[], Program_T *p) {
     p->load_path = NULL;
     p->save_dungeon_path = NULL;
     p->save_pgm_path = NULL;
+    p->record_path = NULL;
+    p->play_path = NULL;
+    p->generate_dir = NULL;
+    p->world_dir = NULL;
     p->num_monsters = 0;
+    p->seed = 0;
 
     // Initialize the argument struct
     a.load = false;
@@ -342,14 +755,39 @@ void init_program(int argc, const char *argv[], Program_T *p) {
     a.stairs = false;
     a.seed = false;
     a.nummon = false;
+    a.height = false;
+    a.width = false;
     a.print = false;
+    a.color = false;
+    a.record_frames = false;
+    a.play_frames = false;
+    a.play_speed = false;
+    a.generate = false;
+    a.out_dir = false;
+    a.threads = false;
+    a.gen_stats = false;
+    a.world = false;
+    a.world_at = false;
     a.help = false;
     a.version = false;
     a.load_path = NULL;
     a.save_dungeon_path = NULL;
     a.save_pgm_path = NULL;
+    a.record_path = NULL;
+    a.play_path = NULL;
+    a.generate_dir = NULL;
+    a.world_dir = NULL;
     a.rand_seed = 0;
     a.num_monsters = DEFAULT_NUM_OF_MONSTERS;
+    a.dungeon_height = DUNGEON_HEIGHT;
+    a.dungeon_width = DUNGEON_WIDTH;
+    a.num_generate = 0;
+    a.num_threads = 0;
+    a.num_gen_stats = 0;
+    a.world_y = 0;
+    a.world_x = 0;
+    a.color_mode = DEFAULT_COLOR_MODE;
+    a.speed = DEFAULT_PLAY_SPEED;
 
     // Read in our arguments
     read_arguments(argc, argv, &a);
@@ -368,13 +806,17 @@ void init_program(int argc, const char *argv[], Program_T *p) {
         exit(NORMAL_EXIT);
     }
 
-    // Set random seed
+    // Set random seed. Every dungeon seeds its own generator off of it.
     if (a.seed) {
-        srand(a.rand_seed);
+        p->seed = a.rand_seed;
     } else {
-        srand((unsigned int) time(NULL)); // NOLINT(cert-msc51-cpp)
+        p->seed = (uint64_t) time(NULL);
     }
 
+    // Build the tables the renderer draws from
+    init_color_codes(a.color_mode);
+    init_glyphs();
+
     // Set up the dungeon_path only if it's not specified on the command line, and we're actually interacting with the disk
     if ((a.load && a.load_path == NULL) || (a.save && a.save_dungeon_path == NULL)) {
         int length;
@@ -453,9 +895,93 @@ void init_program(int argc, const char *argv[], Program_T *p) {
     p->pgm_save = a.pgm_save;
     p->stairs = a.stairs;
     p->print = a.print;
+    p->record_frames = a.record_frames;
+    p->play_frames = a.play_frames;
+    p->record_path = a.record_path;
+    p->play_path = a.play_path;
+
+    // Set up batch generation. The directory is always allocated, so clean up doesn't have to care where it came from.
+    // Without a thread count, use every core we have.
+    p->generate = a.generate;
+    if (a.generate_dir != NULL) {
+        p->generate_dir = a.generate_dir;
+    } else {
+        p->generate_dir = safe_malloc(sizeof(DEFAULT_GENERATE_DIRECTORY));
+        strcpy(p->generate_dir, DEFAULT_GENERATE_DIRECTORY);
+    }
+    p->num_generate = a.num_generate;
+    p->num_threads = a.threads ? a.num_threads : (int) sysconf(_SC_NPROCESSORS_ONLN);
+    if (p->num_threads < 1) {
+        p->num_threads = 1;
+    }
+
+    // Set up generation stats
+    p->gen_stats = a.gen_stats;
+    p->num_gen_stats = a.num_gen_stats;
+
+    // Set up the world. The window has to fit inside of it, and loading a dungeon would mean there's no world to play
+    // in. The directory is always allocated, same as the batch directory.
+    if (a.world && (a.load || a.pgm_load)) {
+        bail(INVALID_ARGUMENT, "World option can't be used with loading a dungeon!\n");
+    }
+    if (a.world_at && !a.world) {
+        bail(INVALID_ARGUMENT, "World at option must be used with the world option!\n");
+    }
+    if (a.world_y > WORLD_HEIGHT - a.dungeon_height || a.world_x > WORLD_WIDTH - a.dungeon_width) {
+        bail(INVALID_ARGUMENT, "Invalid position %i,%i! A %ix%i window must have its corner from 0,0 to %i,%i!\n",
+             a.world_y, a.world_x, a.dungeon_width, a.dungeon_height, WORLD_HEIGHT - a.dungeon_height,
+             WORLD_WIDTH - a.dungeon_width);
+    }
+    p->world = a.world;
+    p->world_y = a.world_y;
+    p->world_x = a.world_x;
+    if (a.world && a.world_dir != NULL) {
+        p->world_dir = a.world_dir;
+
+        // Make the directory if it doesn't exist
+        #if defined(_WIN32)
+        _mkdir(p->world_dir);
+        #else
+        mkdir(p->world_dir, 0700);
+        #endif
+
+    } else if (a.world) {
+        int length;
+
+        // Same as the default dungeon path, but the world gets a directory of its own under it
+        length = 0;
+        if (USE_HOME_DIRECTORY) {
+            length += (int) strlen(getenv("HOME"));
+        }
+        length += strlen(SAVE_PATH);
+        length += strlen(DEFAULT_WORLD_DIRECTORY);
+        length += sizeof(char); // Need to include null terminator
+
+        p->world_dir = safe_calloc((size_t) length, sizeof(char));
+        if (USE_HOME_DIRECTORY) {
+            strcat(p->world_dir, getenv("HOME"));
+        }
+        strcat(p->world_dir, SAVE_PATH);
+
+        // Make both directories if they don't exist
+        #if defined(_WIN32)
+        _mkdir(p->world_dir);
+        #else
+        mkdir(p->world_dir, 0700);
+        #endif
+        strcat(p->world_dir, DEFAULT_WORLD_DIRECTORY);
+        #if defined(_WIN32)
+        _mkdir(p->world_dir);
+        #else
+        mkdir(p->world_dir, 0700);
+        #endif
+    }
 
     // Misc values to return to main
     p->num_monsters = a.num_monsters;
+    p->height = a.dungeon_height;
+    p->width = a.dungeon_width;
+    p->play_speed = a.speed;
 }
 
 // See program-init.h
@@ -471,4 +997,8 @@ void cleanup_program(Program_T *p) {
         free(p->save_dungeon_path);
         free(p->save_pgm_path);
     }
+    free(p->record_path);
+    free(p->play_path);
+    free(p->generate_dir);
+    free(p->world_dir);
 }
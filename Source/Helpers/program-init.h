@@ -2,6 +2,7 @@
 #define ROGUE_PROGRAM_INIT_H
 
 #include <stdbool.h>
+#include <stdint.h>
 
 // Hold all program setting in a struct... makes clean up easier. Paths are are only allocated if we have to and are
 // saving or loading from disk
@@ -12,10 +13,28 @@ typedef struct Program_S {
     bool pgm_save;
     bool stairs;
     bool print;
+    bool record_frames;
+    bool play_frames;
+    bool generate;
+    bool gen_stats;
+    bool world;
     char *load_path;
     char *save_dungeon_path;
     char *save_pgm_path;
+    char *record_path;
+    char *play_path;
+    char *generate_dir;
+    char *world_dir;
     int num_monsters;
+    int height;
+    int width;
+    int num_generate;
+    int num_threads;
+    int num_gen_stats;
+    int world_y;
+    int world_x;
+    uint64_t seed;
+    double play_speed;
 } Program_T;
 
 // Function that initializes settings, and sets up the correct environment for later functions.
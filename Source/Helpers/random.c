@@ -0,0 +1,171 @@
+#include "random.h"
+
+// How many values random_counter_fill_in_range() makes at a time
+#define RANDOM_BLOCK 16
+
+// Helper that rotates bits left, which the compiler turns into a single instruction
+static uint64_t rotate_left(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+// Helper that steps splitmix64, used to spread a seed out over the whole state
+static uint64_t splitmix64(uint64_t *x) {
+    uint64_t z;
+
+    *x += 0x9e3779b97f4a7c15ULL;
+    z = *x;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+// See random.h
+void init_random(Random_T *r, uint64_t seed) {
+    int i;
+
+    for (i = 0; i < 4; i++) {
+        r->s[i] = splitmix64(&seed);
+    }
+}
+
+// See random.h
+uint64_t random_next(Random_T *r) {
+    uint64_t result, t;
+
+    result = rotate_left(r->s[1] * 5, 7) * 9;
+    t = r->s[1] << 17;
+
+    r->s[2] ^= r->s[0];
+    r->s[3] ^= r->s[1];
+    r->s[1] ^= r->s[2];
+    r->s[0] ^= r->s[3];
+    r->s[2] ^= t;
+    r->s[3] = rotate_left(r->s[3], 45);
+
+    return result;
+}
+
+// See random.h
+uint32_t random_bounded(Random_T *r, uint32_t bound) {
+    uint64_t m;
+    uint32_t low;
+
+    // Lemire's method: scale 32 random bits up to the bound with one multiply, keeping the high half. Only the few
+    // values that would make some results more likely than others get thrown out and drawn again, and the division to
+    // find them is skipped almost every time.
+    m = (random_next(r) >> 32) * bound;
+    low = (uint32_t) m;
+    if (low < bound) {
+        uint32_t threshold;
+
+        threshold = -bound % bound;
+        while (low < threshold) {
+            m = (random_next(r) >> 32) * bound;
+            low = (uint32_t) m;
+        }
+    }
+
+    return (uint32_t) (m >> 32);
+}
+
+// See random.h
+int random_int_in_range(Random_T *r, int lower, int upper) {
+    return lower + (int) random_bounded(r, (uint32_t) (upper - lower) + 1);
+}
+
+// See random.h
+bool random_bool(Random_T *r) {
+    return random_next(r) >> 63;
+}
+
+// See random.h
+void random_fill(Random_T *r, uint64_t *out, size_t n) {
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        out[i] = random_next(r);
+    }
+}
+
+// See random.h
+void random_fill_in_range(Random_T *r, int *out, size_t n, int lower, int upper) {
+    uint32_t bound;
+    size_t i;
+
+    // Work the bound out once, instead of once per value
+    bound = (uint32_t) (upper - lower) + 1;
+    for (i = 0; i < n; i++) {
+        out[i] = lower + (int) random_bounded(r, bound);
+    }
+}
+
+// See random.h
+uint64_t random_counter(uint64_t key, uint64_t counter) {
+    uint64_t z;
+
+    // Step straight to where splitmix64 would be after counter steps from key, and mix it the same way
+    z = key + counter * 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+// See random.h
+void random_counter_fill_in_range(uint64_t key, uint64_t counter, int *out, size_t n, int lower, int upper) {
+    uint64_t bound;
+    size_t i, k;
+
+    bound = (uint64_t) (upper - lower) + 1;
+
+    // Whole blocks first. A fixed trip count lets the compiler vectorize them even at -O2, since there's never a
+    // leftover to handle.
+    for (i = 0; i + RANDOM_BLOCK <= n; i += RANDOM_BLOCK) {
+        for (k = 0; k < RANDOM_BLOCK; k++) {
+            out[i + k] = lower + (int) (((random_counter(key, counter + i + k) >> 32) * bound) >> 32);
+        }
+    }
+
+    // Then whatever didn't fill a block
+    for (; i < n; i++) {
+        out[i] = lower + (int) (((random_counter(key, counter + i) >> 32) * bound) >> 32);
+    }
+}
+
+// See random.h
+void random_shuffle(Random_T *r, int *arr, int n) {
+    int i, swap, temp;
+
+    // Start at the last element, pick a random element, and swap them
+    for (i = n - 1; i > 0; i--) {
+        swap = (int) random_bounded(r, (uint32_t) i + 1);
+        temp = arr[i];
+        arr[i] = arr[swap];
+        arr[swap] = temp;
+    }
+}
+
+// See random.h
+void random_jump(Random_T *r) {
+    static const uint64_t jump[4] = {0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL,
+                                     0x39abdc4529b1661cULL};
+    uint64_t s[4];
+    int i, b;
+
+    s[0] = s[1] = s[2] = s[3] = 0;
+    for (i = 0; i < 4; i++) {
+        for (b = 0; b < 64; b++) {
+            if (jump[i] & (1ULL << b)) {
+                s[0] ^= r->s[0];
+                s[1] ^= r->s[1];
+                s[2] ^= r->s[2];
+                s[3] ^= r->s[3];
+            }
+            random_next(r);
+        }
+    }
+
+    r->s[0] = s[0];
+    r->s[1] = s[1];
+    r->s[2] = s[2];
+    r->s[3] = s[3];
+}
@@ -0,0 +1,58 @@
+#ifndef ROGUE_RANDOM_H
+#define ROGUE_RANDOM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// See random.c for helper functions
+
+// State for a xoshiro256** generator. Every dungeon carries its own, and everything random about it (generation,
+// placement, and monster AI) draws from it, so two dungeons never share state. That keeps a seed reproducible no matter
+// what else is running, and lets dungeons be built on different threads without locking.
+//
+// The state is seeded with splitmix64, so any seed (even 0) gives a good starting state.
+typedef struct Random_S {
+    uint64_t s[4];
+} Random_T;
+
+// Seeds a generator
+void init_random(Random_T *r, uint64_t seed);
+
+// Returns the next 64 random bits
+uint64_t random_next(Random_T *r);
+
+// Returns a random integer in [0, bound), without the bias of taking a modulo. Bound must be more than 0.
+uint32_t random_bounded(Random_T *r, uint32_t bound);
+
+// Returns a random integer in the range [lower, upper] (inclusive). LOWER MUST BE <= UPPER.
+int random_int_in_range(Random_T *r, int lower, int upper);
+
+// Returns true half of the time
+bool random_bool(Random_T *r);
+
+// Fills out with n random 64 bit values
+void random_fill(Random_T *r, uint64_t *out, size_t n);
+
+// Fills out with n random integers in the range [lower, upper] (inclusive). LOWER MUST BE <= UPPER.
+void random_fill_in_range(Random_T *r, int *out, size_t n, int lower, int upper);
+
+// Returns 64 random bits for counter under key, without any generator state. The same key and counter always give the
+// same bits, and every counter can be worked out on its own, so values can be made in any order, in parallel, or made
+// again later without keeping them around.
+uint64_t random_counter(uint64_t key, uint64_t counter);
+
+// Fills out with n random integers in the range [lower, upper] (inclusive), from the counters counter, counter + 1, ...
+// under key. Nothing carries over from one value to the next and nothing is thrown out, so the loop vectorizes. Values
+// are scaled into the range with a multiply, which favors some by at most (upper - lower + 1) / 2^32... nothing that
+// matters for a range this side of a few thousand. LOWER MUST BE <= UPPER.
+void random_counter_fill_in_range(uint64_t key, uint64_t counter, int *out, size_t n, int lower, int upper);
+
+// Shuffles the given int array with a Fisher-Yates algorithm. Modifies the array in memory.
+void random_shuffle(Random_T *r, int *arr, int n);
+
+// Jumps the generator ahead 2^128 draws. Jumping copies of one generator gives streams that will never overlap, for
+// handing out to threads.
+void random_jump(Random_T *r);
+
+#endif //ROGUE_RANDOM_H
@@ -0,0 +1,124 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "frame.h"
+#include "glyph.h"
+
+#include "Character/character.h"
+#include "Dungeon/dungeon.h"
+#include "Helpers/helpers.h"
+
+// The most bytes a single cell can take up in a frame: a cursor move, a reset, a background and foreground, and the
+// character
+#define MAX_CELL_BYTES (sizeof("\x1b[65535;65535H") - 1 + sizeof(CONSOLE_RESET) - 1 + 2 * MAX_COLOR_CODE_LENGTH + 1)
+
+// See frame.h
+void init_frame(Frame_T *f, int height, int width) {
+    f->height = height;
+    f->width = width;
+    f->sequence = 0;
+    f->type = safe_malloc(height * width * sizeof(unsigned char));
+    f->occupant = safe_malloc(height * width * sizeof(unsigned char));
+}
+
+// See frame.h
+void capture_frame(Frame_T *f, const Dungeon_T *d) {
+    int i;
+
+    // The type plane is already one byte a cell, so it copies straight over, and nobody is anywhere yet
+    memcpy(f->type, d->types, (size_t) d->height * d->width);
+    memset(f->occupant, NO_OCCUPANT, (size_t) d->height * d->width);
+
+    // Then stamp everyone where they're standing, encoded so we don't keep an id to a character that might die before
+    // we draw. Only the living are in the dungeon.
+    for (i = 0; i < d->monsters.count; i++) {
+        if (d->monsters.alive[i]) {
+            f->FRAME_OCCUPANT(d->monsters.y[i], d->monsters.x[i]) =
+                    (unsigned char) (MONSTER_OCCUPANT + d->monsters.behavior[i]);
+        }
+    }
+    if (d->player != NULL) {
+        f->FRAME_OCCUPANT(d->player->y, d->player->x) = PC_OCCUPANT;
+    }
+
+    f->sequence++;
+}
+
+// See frame.h
+size_t frame_output_size(const Frame_T *f) {
+    return (size_t) f->height * ((size_t) f->width * MAX_CELL_BYTES + 1) + 1;
+}
+
+// See frame.h
+void render_frame(Output_T *o, const Frame_T *f) {
+    int i, j;
+
+    for (i = 0; i < f->height; i++) {
+        for (j = 0; j < f->width; j++) {
+            output_glyph(o, &glyphs[f->FRAME_TYPE(i, j)][f->FRAME_OCCUPANT(i, j)]);
+        }
+
+        // Print a new line after every row. Reset first, so the background doesn't bleed if the terminal scrolls.
+        output_reset(o);
+        output_char(o, '\n');
+    }
+
+    // Print a new line after the last row to space multiple maps apart
+    output_char(o, '\n');
+}
+
+// See frame.h
+void render_frame_changes(Output_T *o, const Frame_T *f, const Frame_T *previous) {
+    int i, j;
+
+    for (i = 0; i < f->height; i++) {
+        bool adjacent;
+
+        // Keeps track if the cursor is already sitting on this cell because we just drew the one to the left of it
+        adjacent = false;
+
+        for (j = 0; j < f->width; j++) {
+
+            // Skip anything the terminal is already showing
+            if (f->FRAME_TYPE(i, j) == previous->FRAME_TYPE(i, j) &&
+                f->FRAME_OCCUPANT(i, j) == previous->FRAME_OCCUPANT(i, j)) {
+                adjacent = false;
+                continue;
+            }
+
+            // Jump to the cell only if we have to, and draw it
+            if (!adjacent) {
+                output_cursor(o, i, j);
+            }
+            output_glyph(o, &glyphs[f->FRAME_TYPE(i, j)][f->FRAME_OCCUPANT(i, j)]);
+            adjacent = true;
+        }
+    }
+
+    // Leave the cursor where a full frame would have left it, under the map, with the colors back to normal
+    output_reset(o);
+    output_cursor(o, f->height + 1, 0);
+}
+
+// See frame.h
+void copy_frame(Frame_T *dst, const Frame_T *src) {
+    memcpy(dst->type, src->type, (size_t) src->height * src->width * sizeof(unsigned char));
+    memcpy(dst->occupant, src->occupant, (size_t) src->height * src->width * sizeof(unsigned char));
+    dst->sequence = src->sequence;
+}
+
+// See frame.h
+void print_frame(const Frame_T *f) {
+    Output_T o;
+
+    init_output(&o, frame_output_size(f));
+    render_frame(&o, f);
+    output_flush(&o);
+    cleanup_output(&o);
+}
+
+// See frame.h
+void cleanup_frame(Frame_T *f) {
+    free(f->type);
+    free(f->occupant);
+}
@@ -0,0 +1,59 @@
+#ifndef ROGUE_FRAME_H
+#define ROGUE_FRAME_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "output.h"
+
+// See frame.c for helper functions
+
+// Define macros to help obfuscate bare pointer arithmetic, same as TYPE() for dungeons
+#define FRAME_TYPE(a, b) type[(a) * f->width + (b)]
+#define FRAME_OCCUPANT(a, b) occupant[(a) * f->width + (b)]
+
+// Encodes what is standing on a cell in a frame. Monsters are stored as MONSTER_OCCUPANT + behavior, so a frame never
+// has to point back into the dungeon, and can be drawn safely while the dungeon keeps changing.
+#define NO_OCCUPANT 0
+#define PC_OCCUPANT 1
+#define MONSTER_OCCUPANT 2
+
+// Forward declare so we don't have to include the dungeon header
+typedef struct Dungeon_S Dungeon_T;
+
+// An immutable snapshot of everything needed to draw a dungeon. Cell types and occupants are stored as byte planes so
+// a capture is a cheap linear pass, and the frame can be handed off to another thread without any locking.
+typedef struct Frame_S {
+    int height, width;
+    unsigned long long sequence;
+    unsigned char *type;
+    unsigned char *occupant;
+} Frame_T;
+
+// Allocates the planes for a frame of the given size
+void init_frame(Frame_T *f, int height, int width);
+
+// Copies the current state of the dungeon into the frame. The frame must be the same size as the dungeon.
+void capture_frame(Frame_T *f, const Dungeon_T *d);
+
+// Returns the most bytes render_frame() or render_frame_changes() could ever need for this frame, so output buffers
+// can be allocated once
+size_t frame_output_size(const Frame_T *f);
+
+// Composes the entire frame into the output buffer, without writing anything to the terminal
+void render_frame(Output_T *o, const Frame_T *f);
+
+// Composes only the cells that differ from the previous frame, jumping the cursor to each run of changed cells. Assumes
+// the terminal is showing the previous frame, drawn by render_frame() from the top left corner.
+void render_frame_changes(Output_T *o, const Frame_T *f, const Frame_T *previous);
+
+// Copies one frame into another of the same size
+void copy_frame(Frame_T *dst, const Frame_T *src);
+
+// Prints a frame out to the console in a single write. Allocates its own buffer, so it's meant for one off prints.
+void print_frame(const Frame_T *f);
+
+// Frees the planes of a frame, but not the frame itself
+void cleanup_frame(Frame_T *f);
+
+#endif //ROGUE_FRAME_H
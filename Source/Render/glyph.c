@@ -0,0 +1,95 @@
+#include <string.h>
+
+#include "glyph.h"
+
+#include "Settings/print-settings.h"
+
+// See glyph.h
+Glyph_T glyphs[NUM_CELL_TYPES][NUM_OCCUPANTS];
+
+// Helper that resolves a single glyph, and encodes its bytes
+static void init_glyph(Glyph_T *g, Color_T foreground, Color_T background, char symbol) {
+    const char *code;
+    size_t length;
+
+    g->foreground = foreground;
+    g->background = background;
+    g->symbol = symbol;
+    g->length = 0;
+
+    // Background code first
+    if (background != NO_COLOR) {
+        code = color_code(background, true, &length);
+        memcpy(&g->bytes[g->length], code, length);
+        g->length += length;
+    }
+    g->foreground_offset = g->length;
+
+    // Then the foreground code
+    if (foreground != NO_COLOR) {
+        code = color_code(foreground, false, &length);
+        memcpy(&g->bytes[g->length], code, length);
+        g->length += length;
+    }
+    g->symbol_offset = g->length;
+
+    // And finally the symbol itself
+    g->bytes[g->length] = symbol;
+    g->length++;
+}
+
+// See glyph.h
+void init_glyphs() {
+    int type, behavior;
+    bool plain;
+
+    // Without colors, the bare cells need actual characters to tell them apart
+    plain = color_mode() == NO_COLOR_MODE;
+
+    for (type = 0; type < NUM_CELL_TYPES; type++) {
+
+        // The bare cell
+        init_glyph(&glyphs[type][NO_OCCUPANT], cell_type_color(type), cell_type_background(type),
+                   plain ? cell_type_plain_char(type) : cell_type_char(type));
+
+        // The PC standing on the cell
+        init_glyph(&glyphs[type][PC_OCCUPANT], PC_COLOR, cell_type_background(type), PC_SYMBOL);
+
+        // Every type of monster standing on the cell
+        for (behavior = 0; behavior < NUM_MONSTER_TYPES; behavior++) {
+            init_glyph(&glyphs[type][MONSTER_OCCUPANT + behavior], monster_behavior_color(behavior),
+                       cell_type_background(type), monster_behavior_char(behavior));
+        }
+    }
+}
+
+// See glyph.h
+void output_glyph(Output_T *o, const Glyph_T *g) {
+    bool background, foreground;
+
+    // Anything that needs to go back to the terminal's default colors needs a reset, so let output_cell() handle it
+    if (g->foreground == NO_COLOR || g->background == NO_COLOR) {
+        output_cell(o, g->foreground, g->background, g->symbol);
+        return;
+    }
+
+    // Figure out which colors we actually need to send. The foreground of a space can't be seen.
+    background = g->background != o->background;
+    foreground = g->symbol != ' ' && g->foreground != o->foreground;
+
+    // Copy out whichever pieces of the glyph we need
+    if (background && foreground) {
+        output_bytes(o, g->bytes, g->length);
+    } else if (foreground) {
+        output_bytes(o, &g->bytes[g->foreground_offset], g->length - g->foreground_offset);
+    } else if (background) {
+        output_bytes(o, g->bytes, g->foreground_offset);
+        output_char(o, g->symbol);
+    } else {
+        output_char(o, g->symbol);
+    }
+
+    // Keep track of what the terminal is using now
+    o->background = g->background;
+    o->foreground = foreground ? g->foreground : o->foreground;
+}
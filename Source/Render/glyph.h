@@ -0,0 +1,35 @@
+#ifndef ROGUE_GLYPH_H
+#define ROGUE_GLYPH_H
+
+#include "output.h"
+#include "frame.h"
+
+#include "Character/character.h"
+#include "Dungeon/dungeon.h"
+
+// See glyph.c for helper functions
+
+// How many different occupants a frame cell can have: nobody, the PC, or one of every type of monster
+#define NUM_OCCUPANTS (MONSTER_OCCUPANT + NUM_MONSTER_TYPES)
+
+// A fully resolved cell as it's drawn on the terminal. Bytes holds the pre-encoded background code, foreground code and
+// symbol back to back, so drawing a cell is at most a couple of memcpy()s. The offsets let us skip either code when the
+// terminal is already using that color.
+typedef struct Glyph_S {
+    Color_T foreground, background;
+    char symbol;
+    unsigned char foreground_offset, symbol_offset, length;
+    char bytes[2 * MAX_COLOR_CODE_LENGTH + 1];
+} Glyph_T;
+
+// Table of every (cell type, occupant) combination. Built once by init_glyphs(), and read only after that, so any
+// thread can draw from it.
+extern Glyph_T glyphs[NUM_CELL_TYPES][NUM_OCCUPANTS];
+
+// Builds the glyph table. Must be called once at startup, after init_color_codes(), before anything is drawn.
+void init_glyphs();
+
+// Appends a glyph to the output, sending only the colors the terminal isn't already using
+void output_glyph(Output_T *o, const Glyph_T *g);
+
+#endif //ROGUE_GLYPH_H
@@ -0,0 +1,293 @@
+// We have to include this macro so gcc shuts up and will actually compile
+// I think this is what I get for wanting to compile against C11
+#define _POSIX_C_SOURCE 200809L // NOLINT(bugprone-reserved-identifier)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+
+#include "output.h"
+
+// Escape codes for every color in the palette, built off of the RGB values in helpers.h by init_color_codes(). Lengths
+// are stored alongside so we never have to strlen() them.
+typedef struct Color_Code_S {
+    char code[MAX_COLOR_CODE_LENGTH + 1];
+    size_t length;
+} Color_Code_T;
+
+#define PALETTE_RGB(name, red, green, blue) {red, green, blue},
+static const unsigned char palette_rgb[NUM_COLORS][3] = {PALETTE(PALETTE_RGB)};
+#undef PALETTE_RGB
+
+// The 16 basic colors, as xterm draws them by default. Used to find the closest one to each color in the palette.
+static const unsigned char basic_rgb[16][3] = {
+        {0,   0,   0},
+        {205, 0,   0},
+        {0,   205, 0},
+        {205, 205, 0},
+        {0,   0,   238},
+        {205, 0,   205},
+        {0,   205, 205},
+        {229, 229, 229},
+        {127, 127, 127},
+        {255, 0,   0},
+        {0,   255, 0},
+        {255, 255, 0},
+        {92,  92,  255},
+        {255, 0,   255},
+        {0,   255, 255},
+        {255, 255, 255}
+};
+
+// Each level a channel can take in the 6x6x6 color cube of the 256 color palette
+static const int cube_levels[6] = {0, 95, 135, 175, 215, 255};
+
+static Color_Code_T foreground_codes[NUM_COLORS];
+static Color_Code_T background_codes[NUM_COLORS];
+static Color_Code_T reset_code;
+static Color_Mode_T current_mode = TRUECOLOR_MODE;
+
+// Names for each mode, in the same order as the enum, for reading them off the command line
+static const char *color_mode_names[NUM_COLOR_MODES] = {"truecolor", "256", "16", "none"};
+
+// Helper that gives the squared distance between two colors. Not perceptually perfect, but plenty to pick a neighbor.
+static int color_distance(int red, int green, int blue, const unsigned char rgb[3]) {
+    return (red - rgb[0]) * (red - rgb[0]) + (green - rgb[1]) * (green - rgb[1]) + (blue - rgb[2]) * (blue - rgb[2]);
+}
+
+// Helper that finds the closest index in the 256 color palette. Checks both the closest spot in the color cube and the
+// closest step of the grey ramp, since the ramp is a lot finer for anything without much color to it.
+static int closest_256(int red, int green, int blue) {
+    unsigned char cube[3], grey[3];
+    int channels[3], indexes[3], grey_index, i, j;
+
+    channels[0] = red;
+    channels[1] = green;
+    channels[2] = blue;
+
+    // Snap every channel to its closest level in the cube
+    for (i = 0; i < 3; i++) {
+        indexes[i] = 0;
+        for (j = 1; j < 6; j++) {
+            if (abs(channels[i] - cube_levels[j]) < abs(channels[i] - cube_levels[indexes[i]])) {
+                indexes[i] = j;
+            }
+        }
+        cube[i] = (unsigned char) cube_levels[indexes[i]];
+    }
+
+    // The grey ramp runs from 8 to 238 in steps of 10
+    grey_index = ((red + green + blue) / 3 - 8 + 5) / 10;
+    grey_index = grey_index < 0 ? 0 : grey_index > 23 ? 23 : grey_index;
+    grey[0] = grey[1] = grey[2] = (unsigned char) (8 + 10 * grey_index);
+
+    if (color_distance(red, green, blue, grey) < color_distance(red, green, blue, cube)) {
+        return 232 + grey_index;
+    }
+    return 16 + 36 * indexes[0] + 6 * indexes[1] + indexes[2];
+}
+
+// Helper that finds the closest of the 16 basic colors
+static int closest_16(int red, int green, int blue) {
+    int i, best;
+
+    best = 0;
+    for (i = 1; i < 16; i++) {
+        if (color_distance(red, green, blue, basic_rgb[i]) < color_distance(red, green, blue, basic_rgb[best])) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+// Helper that builds the code to set one color in the current mode
+static void init_color_code(Color_Code_T *code, const unsigned char rgb[3], bool background) {
+    int n, basic;
+
+    switch (current_mode) {
+        case TRUECOLOR_MODE:
+            n = snprintf(code->code, sizeof(code->code), "\x1b[%i;2;%i;%i;%im", background ? 48 : 38, rgb[0], rgb[1],
+                         rgb[2]);
+            break;
+        case COLOR_256_MODE:
+            n = snprintf(code->code, sizeof(code->code), "\x1b[%i;5;%im", background ? 48 : 38,
+                         closest_256(rgb[0], rgb[1], rgb[2]));
+            break;
+        case COLOR_16_MODE:
+
+            // The bright half of the basic colors has its own set of codes
+            basic = closest_16(rgb[0], rgb[1], rgb[2]);
+            n = snprintf(code->code, sizeof(code->code), "\x1b[%im",
+                         (background ? 40 : 30) + (basic < 8 ? basic : basic - 8 + 60));
+            break;
+        default:
+            n = 0;
+            code->code[0] = (char) 0;
+            break;
+    }
+    code->length = (size_t) n;
+}
+
+// See output.h
+void init_color_codes(Color_Mode_T mode) {
+    int i;
+
+    current_mode = mode;
+    for (i = 0; i < NUM_COLORS; i++) {
+        init_color_code(&foreground_codes[i], palette_rgb[i], false);
+        init_color_code(&background_codes[i], palette_rgb[i], true);
+    }
+
+    // Without colors there's nothing to ever reset
+    if (mode == NO_COLOR_MODE) {
+        reset_code.code[0] = (char) 0;
+        reset_code.length = 0;
+    } else {
+        strcpy(reset_code.code, CONSOLE_RESET);
+        reset_code.length = sizeof(CONSOLE_RESET) - 1;
+    }
+}
+
+// See output.h
+Color_Mode_T color_mode() {
+    return current_mode;
+}
+
+// See output.h
+bool parse_color_mode(const char *s, Color_Mode_T *mode) {
+    int i;
+
+    for (i = 0; i < NUM_COLOR_MODES; i++) {
+        if (strcmp(s, color_mode_names[i]) == 0) {
+            *mode = (Color_Mode_T) i;
+            return true;
+        }
+    }
+    return false;
+}
+
+// See output.h
+const char *color_code(Color_T c, bool background, size_t *length) {
+    const Color_Code_T *codes;
+
+    codes = background ? background_codes : foreground_codes;
+    *length = codes[c].length;
+    return codes[c].code;
+}
+
+// Helper that makes sure there's room for n more bytes in the buffer. Doubles the capacity so appending is amortized
+// constant time if a caller undersized the buffer.
+static void output_reserve(Output_T *o, size_t n) {
+    if (o->length + n > o->capacity) {
+        while (o->length + n > o->capacity) {
+            o->capacity *= 2;
+        }
+        o->buffer = safe_realloc(o->buffer, o->capacity);
+    }
+}
+
+// See output.h
+void init_output(Output_T *o, size_t capacity) {
+    o->capacity = capacity > 0 ? capacity : 1;
+    o->length = 0;
+    o->buffer = safe_malloc(o->capacity);
+    o->foreground = NO_COLOR;
+    o->background = NO_COLOR;
+}
+
+// See output.h
+void output_bytes(Output_T *o, const char *bytes, size_t n) {
+    output_reserve(o, n);
+    memcpy(&o->buffer[o->length], bytes, n);
+    o->length += n;
+}
+
+// See output.h
+void output_string(Output_T *o, const char *s) {
+    output_bytes(o, s, strlen(s));
+}
+
+// See output.h
+void output_char(Output_T *o, char c) {
+    output_reserve(o, 1);
+    o->buffer[o->length] = c;
+    o->length++;
+}
+
+// See output.h
+void output_cell(Output_T *o, Color_T foreground, Color_T background, char c) {
+
+    // The foreground of a space can't be seen, so don't waste bytes changing it
+    if (c == ' ') {
+        foreground = o->foreground;
+    }
+
+    // There's no code to set just one of the colors back to default, so we need a full reset to go back to one
+    if ((foreground == NO_COLOR && o->foreground != NO_COLOR) ||
+        (background == NO_COLOR && o->background != NO_COLOR)) {
+        output_reset(o);
+    }
+
+    // Only send the colors that changed
+    if (background != o->background) {
+        output_bytes(o, background_codes[background].code, background_codes[background].length);
+        o->background = background;
+    }
+    if (foreground != o->foreground) {
+        output_bytes(o, foreground_codes[foreground].code, foreground_codes[foreground].length);
+        o->foreground = foreground;
+    }
+
+    output_char(o, c);
+}
+
+// See output.h
+void output_reset(Output_T *o) {
+    if (o->foreground != NO_COLOR || o->background != NO_COLOR) {
+        output_bytes(o, reset_code.code, reset_code.length);
+        o->foreground = NO_COLOR;
+        o->background = NO_COLOR;
+    }
+}
+
+// See output.h
+void output_cursor(Output_T *o, int row, int column) {
+    char sequence[32];
+    int n;
+
+    // Terminals count from 1, not 0
+    n = snprintf(sequence, sizeof(sequence), "\x1b[%i;%iH", row + 1, column + 1);
+    output_bytes(o, sequence, (size_t) n);
+}
+
+// See output.h
+void output_flush(Output_T *o) {
+    size_t written;
+
+    fflush(stdout);
+
+    // write() is allowed to do less than we ask, or get interrupted, so keep going until it's all out
+    written = 0;
+    while (written < o->length) {
+        ssize_t n;
+
+        n = write(STDOUT_FILENO, &o->buffer[written], o->length - written);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            fprintf(stderr, "Failed to write frame to the terminal!\n");
+            break;
+        }
+        written += (size_t) n;
+    }
+
+    o->length = 0;
+}
+
+// See output.h
+void cleanup_output(Output_T *o) {
+    free(o->buffer);
+}
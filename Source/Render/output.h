@@ -0,0 +1,76 @@
+#ifndef ROGUE_OUTPUT_H
+#define ROGUE_OUTPUT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "Helpers/helpers.h"
+
+// See output.c for helper functions
+
+// The longest escape code we can emit to set a color: a 24-bit foreground or background
+#define MAX_COLOR_CODE_LENGTH (sizeof("\x1b[38;2;255;255;255m") - 1)
+
+// How colors are sent to the terminal. Truecolor sends the exact RGB of every color, 256 and 16 send the closest color
+// the terminal has in its palette with much shorter codes, and none doesn't send colors at all.
+typedef enum Color_Mode_E {
+    TRUECOLOR_MODE, COLOR_256_MODE, COLOR_16_MODE, NO_COLOR_MODE, NUM_COLOR_MODES
+} Color_Mode_T;
+
+// A byte buffer that an entire screen of output is composed into, so it can be handed to the terminal with a single
+// write() instead of thousands of formatted prints. The buffer is meant to be allocated once up front and reused for
+// every frame; it will grow if it has to, but callers should size it for their worst case so it never does.
+//
+// The output also keeps track of the foreground and background the terminal will be using once everything in the
+// buffer has been written, so colors are only sent when they actually change. Runs of rock or room floor end up costing
+// one byte a cell instead of a full set of colors and a reset.
+typedef struct Output_S {
+    char *buffer;
+    size_t length, capacity;
+    Color_T foreground, background;
+} Output_T;
+
+// Builds the escape codes for every color in the palette in the given mode. Must be called once at startup, before
+// anything is drawn, and before init_glyphs() since the glyphs are built out of these codes.
+void init_color_codes(Color_Mode_T mode);
+
+// Returns the mode the color codes were built for
+Color_Mode_T color_mode();
+
+// Reads a mode from its name on the command line: truecolor, 256, 16, or none. Returns false if the name isn't a mode.
+bool parse_color_mode(const char *s, Color_Mode_T *mode);
+
+// Returns the escape code to set a color in the foreground or background, storing its length in length
+const char *color_code(Color_T c, bool background, size_t *length);
+
+// Allocates an output buffer with room for capacity bytes
+void init_output(Output_T *o, size_t capacity);
+
+// Appends n bytes onto the end of the buffer
+void output_bytes(Output_T *o, const char *bytes, size_t n);
+
+// Appends a null terminated string onto the end of the buffer
+void output_string(Output_T *o, const char *s);
+
+// Appends a single character onto the end of the buffer
+void output_char(Output_T *o, char c);
+
+// Appends a character drawn in the given colors, sending only the colors that differ from what the terminal is already
+// using. Spaces don't show their foreground, so it's left alone for them.
+void output_cell(Output_T *o, Color_T foreground, Color_T background, char c);
+
+// Appends a reset back to the terminal's default colors, if we aren't already using them. Nothing is sent with colors
+// turned off.
+void output_reset(Output_T *o);
+
+// Appends the key combo to move the cursor to the given row and column, both starting at 0
+void output_cursor(Output_T *o, int row, int column);
+
+// Writes everything in the buffer to stdout in as few write() calls as the OS will let us, and empties the buffer.
+// Flushes stdio first, so anything printf()'d before lands on the terminal in the right order.
+void output_flush(Output_T *o);
+
+// Frees the buffer, but not the output itself
+void cleanup_output(Output_T *o);
+
+#endif //ROGUE_OUTPUT_H
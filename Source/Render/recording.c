@@ -0,0 +1,250 @@
+// We have to include this macro so gcc shuts up and will actually compile
+// I think this is what I get for wanting to compile against C11
+#define _POSIX_C_SOURCE 200809L // NOLINT(bugprone-reserved-identifier)
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "recording.h"
+#include "glyph.h"
+#include "renderer.h"
+
+#include "Helpers/helpers.h"
+#include "Helpers/pacer.h"
+#include "Settings/file-settings.h"
+#include "Settings/misc-settings.h"
+
+// Sizes of the fixed parts of the file, see recording.h
+#define FRAME_HEADER_SIZE (sizeof(FRAME_FILE_MARKER) - 1 + sizeof(uint32_t) + sizeof(uint16_t) * 2)
+#define RECORD_HEADER_SIZE (sizeof(uint32_t) * 2)
+#define RUN_HEADER_SIZE (sizeof(uint32_t) + sizeof(uint16_t))
+
+// See recording.h
+Recorder_T *new_recorder(const char *path, int height, int width) {
+    Recorder_T *r;
+    unsigned char header[FRAME_HEADER_SIZE];
+    size_t cells;
+    FILE *f;
+
+    // Try to open the file... don't need to do the other work if it doesn't open
+    f = fopen(path, "wb");
+    if (f == NULL) {
+        fprintf(stderr, "Couldn't open file %s! Unable to record!\n", path);
+        return NULL;
+    }
+
+    r = safe_malloc(sizeof(Recorder_T));
+    r->file = f;
+    r->frames = 0;
+    r->bytes = FRAME_HEADER_SIZE;
+    r->elapsed = 0;
+    clock_gettime(CLOCK_MONOTONIC, &r->start);
+
+    // Set up our frames. The previous frame starts off with types that can't exist, so the first record has every cell.
+    cells = (size_t) height * width;
+    init_frame(&r->previous, height, width);
+    init_frame(&r->current, height, width);
+    memset(r->previous.type, UINT8_MAX, cells);
+    memset(r->previous.occupant, UINT8_MAX, cells);
+
+    // Worst case is every other cell changing, so every cell is its own run
+    r->buffer = safe_malloc(RECORD_HEADER_SIZE + cells * (RUN_HEADER_SIZE + 2));
+
+    // Write out the header
+    memcpy(header, FRAME_FILE_MARKER, sizeof(FRAME_FILE_MARKER) - 1);
+    write_value(&header[sizeof(FRAME_FILE_MARKER) - 1], FRAME_FILE_VERSION, sizeof(uint32_t));
+    write_value(&header[sizeof(FRAME_FILE_MARKER) - 1 + sizeof(uint32_t)], (uint64_t) height, sizeof(uint16_t));
+    write_value(&header[sizeof(FRAME_FILE_MARKER) - 1 + sizeof(uint32_t) + sizeof(uint16_t)], (uint64_t) width,
+                sizeof(uint16_t));
+    fwrite(header, 1, FRAME_HEADER_SIZE, f);
+
+    return r;
+}
+
+// See recording.h
+void record_frame(Recorder_T *r, const Dungeon_T *d) {
+    struct timespec now, done;
+    Frame_T swap;
+    size_t i, cells, p;
+    uint32_t runs;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    capture_frame(&r->current, d);
+
+    // Walk the frame looking for runs of changed cells, leaving room for the record header at the front
+    cells = (size_t) r->current.height * r->current.width;
+    p = RECORD_HEADER_SIZE;
+    runs = 0;
+    i = 0;
+    while (i < cells) {
+        size_t start, length;
+
+        // Skip anything that's the same as last time
+        if (r->current.type[i] == r->previous.type[i] && r->current.occupant[i] == r->previous.occupant[i]) {
+            i++;
+            continue;
+        }
+
+        // Copy out the run, leaving room for its header. Runs are capped so the length fits.
+        start = i;
+        p += RUN_HEADER_SIZE;
+        while (i < cells && i - start < UINT16_MAX &&
+               (r->current.type[i] != r->previous.type[i] || r->current.occupant[i] != r->previous.occupant[i])) {
+            r->buffer[p] = r->current.type[i];
+            r->buffer[p + 1] = r->current.occupant[i];
+            p += 2;
+            i++;
+        }
+
+        // Go back and fill in the header
+        length = i - start;
+        write_value(&r->buffer[p - length * 2 - RUN_HEADER_SIZE], start, sizeof(uint32_t));
+        write_value(&r->buffer[p - length * 2 - sizeof(uint16_t)], length, sizeof(uint16_t));
+        runs++;
+    }
+
+    // Only bother writing if something changed
+    if (runs > 0) {
+
+        // Fill in the record header, and hand it all to stdio in one go
+        write_value(r->buffer, (uint32_t) (time_difference(&now, &r->start) / 1000000), sizeof(uint32_t));
+        write_value(&r->buffer[sizeof(uint32_t)], runs, sizeof(uint32_t));
+        fwrite(r->buffer, 1, p, r->file);
+        r->frames++;
+        r->bytes += p;
+
+        // What we just recorded is what the next frame gets compared against
+        swap = r->previous;
+        r->previous = r->current;
+        r->current = swap;
+    }
+
+    // Keep track of what recording costs us
+    clock_gettime(CLOCK_MONOTONIC, &done);
+    r->elapsed += time_difference(&done, &now);
+}
+
+// See recording.h
+void print_recorder_stats(const Recorder_T *r) {
+    fprintf(stderr, "Recorder: %llu frames in %llu bytes, %.1fus per frame\n", r->frames, r->bytes,
+            r->frames > 0 ? (double) r->elapsed / 1000 / (double) r->frames : 0);
+}
+
+// See recording.h
+void cleanup_recorder(Recorder_T *r) {
+    if (fclose(r->file) != 0) {
+        fprintf(stderr, "Failed to finish writing the recording!\n");
+    }
+    cleanup_frame(&r->previous);
+    cleanup_frame(&r->current);
+    free(r->buffer);
+    free(r);
+}
+
+// See recording.h
+void play_recording(const char *path, double speed) {
+    unsigned char header[FRAME_HEADER_SIZE], *cells;
+    Renderer_T *r;
+    Pacer_T pacer;
+    Frame_T frame;
+    size_t num_cells, read;
+    int height, width;
+    FILE *f;
+
+    // Try to open the file
+    f = fopen(path, "rb");
+    if (f == NULL) {
+        fprintf(stderr, "Couldn't open file %s! Unable to play!\n", path);
+        return;
+    }
+
+    // Check the semantics of the header, same as a saved dungeon
+    if (fread(header, 1, FRAME_HEADER_SIZE, f) != FRAME_HEADER_SIZE ||
+        memcmp(header, FRAME_FILE_MARKER, sizeof(FRAME_FILE_MARKER) - 1) != 0) {
+        fprintf(stderr, "Invalid recording %s! Unable to play!\n", path);
+        fclose(f);
+        return;
+    }
+    if (read_value(&header[sizeof(FRAME_FILE_MARKER) - 1], sizeof(uint32_t)) != FRAME_FILE_VERSION) {
+        fprintf(stderr, "Invalid recording version %u! Unable to play!\n",
+                (uint32_t) read_value(&header[sizeof(FRAME_FILE_MARKER) - 1], sizeof(uint32_t)));
+        fclose(f);
+        return;
+    }
+    height = (int) read_value(&header[sizeof(FRAME_FILE_MARKER) - 1 + sizeof(uint32_t)], sizeof(uint16_t));
+    width = (int) read_value(&header[sizeof(FRAME_FILE_MARKER) - 1 + sizeof(uint32_t) + sizeof(uint16_t)],
+                             sizeof(uint16_t));
+    if (height == 0 || width == 0) {
+        fprintf(stderr, "Invalid recording size %ix%i! Unable to play!\n", height, width);
+        fclose(f);
+        return;
+    }
+
+    // Everything starts off as empty rock, and gets filled in by the first record
+    num_cells = (size_t) height * width;
+    init_frame(&frame, height, width);
+    memset(frame.type, ROCK, num_cells);
+    memset(frame.occupant, NO_OCCUPANT, num_cells);
+    cells = safe_malloc(num_cells * 2);
+
+    r = new_renderer(height, width);
+    init_pacer(&pacer, FPS);
+
+    // Apply records one at a time, until we run out of file
+    while ((read = fread(header, 1, RECORD_HEADER_SIZE, f)) == RECORD_HEADER_SIZE) {
+        uint32_t time, runs, i;
+        bool valid;
+
+        time = (uint32_t) read_value(header, sizeof(uint32_t));
+        runs = (uint32_t) read_value(&header[sizeof(uint32_t)], sizeof(uint32_t));
+
+        // Patch every run into the frame, making sure it stays in bounds and only has things we know how to draw
+        valid = true;
+        for (i = 0; i < runs && valid; i++) {
+            size_t start, length, j;
+
+            if (fread(header, 1, RUN_HEADER_SIZE, f) != RUN_HEADER_SIZE) {
+                valid = false;
+                break;
+            }
+            start = read_value(header, sizeof(uint32_t));
+            length = read_value(&header[sizeof(uint32_t)], sizeof(uint16_t));
+            if (start + length > num_cells || fread(cells, 2, length, f) != length) {
+                valid = false;
+                break;
+            }
+            for (j = 0; j < length; j++) {
+                if (cells[j * 2] >= NUM_CELL_TYPES || cells[j * 2 + 1] >= NUM_OCCUPANTS) {
+                    valid = false;
+                    break;
+                }
+                frame.type[start + j] = cells[j * 2];
+                frame.occupant[start + j] = cells[j * 2 + 1];
+            }
+        }
+        if (!valid) {
+            fprintf(stderr, "Recording %s is corrupt! Stopping playback!\n", path);
+            break;
+        }
+
+        // Wait until it's time for the frame to show, and hand it off
+        frame.sequence++;
+        pacer_wait_until(&pacer, (long long) ((double) time * 1000000 / speed));
+        renderer_publish_frame(r, &frame);
+    }
+    if (read != 0 && read != RECORD_HEADER_SIZE) {
+        fprintf(stderr, "Recording %s is truncated! Stopping playback!\n", path);
+    }
+
+    // Let the renderer catch up, and report how well we kept time
+    stop_renderer(r);
+    print_pacer_stats(&pacer, "Playback");
+    print_pacer_stats(&r->pacer, "Renderer");
+
+    // Cleanup
+    cleanup_renderer(r);
+    cleanup_frame(&frame);
+    free(cells);
+    fclose(f);
+}
@@ -0,0 +1,47 @@
+#ifndef ROGUE_RECORDING_H
+#define ROGUE_RECORDING_H
+
+#include <stdio.h>
+#include <time.h>
+
+#include "frame.h"
+
+// See recording.c for helper functions
+
+// A recorder writes every frame of a game out to a file, so it can be watched later with play_recording() instead of
+// drawn live. Only the cells that changed since the last recorded frame are written, as runs of (type, occupant) pairs,
+// along with the time the frame was captured. The file starts off with a header of FRAME_FILE_MARKER, the version, and
+// the size of the frames. Everything is big endian, same as saved dungeons.
+//
+// Header:  marker, uint32 version, uint16 height, uint16 width
+// Record:  uint32 milliseconds since the recording started, uint32 number of runs, then every run
+// Run:     uint32 index of the first cell (row * width + column), uint16 length, then length (type, occupant) pairs
+//
+// Recording is meant to be a lot cheaper than drawing: it's one pass over the map, and writes go out through stdio's
+// buffer instead of to the terminal.
+typedef struct Recorder_S {
+    FILE *file;
+    Frame_T previous, current;
+    struct timespec start;
+    unsigned char *buffer;
+    unsigned long long frames, bytes;
+    long long elapsed;
+} Recorder_T;
+
+// Returns a new recorder writing frames of the given size to path, or NULL if the file couldn't be opened
+Recorder_T *new_recorder(const char *path, int height, int width);
+
+// Captures the dungeon, and writes out whatever changed since the last frame that was recorded
+void record_frame(Recorder_T *r, const Dungeon_T *d);
+
+// Prints how many frames were recorded, how big they were, and how long recording them took to stderr
+void print_recorder_stats(const Recorder_T *r);
+
+// Flushes and closes the file, and frees the recorder
+void cleanup_recorder(Recorder_T *r);
+
+// Plays back a recording through the renderer, speed times faster than it was recorded. Complains on stderr and
+// returns if the file can't be read.
+void play_recording(const char *path, double speed);
+
+#endif //ROGUE_RECORDING_H
@@ -0,0 +1,165 @@
+// We have to include this macro so gcc shuts up and will actually compile
+// I think this is what I get for wanting to compile against C11
+#define _POSIX_C_SOURCE 200809L // NOLINT(bugprone-reserved-identifier)
+
+#include <stdlib.h>
+
+#include "renderer.h"
+
+#include "Helpers/helpers.h"
+#include "Settings/exit-codes.h"
+#include "Settings/misc-settings.h"
+#include "Settings/print-settings.h"
+
+// Helper that gets a frame onto the terminal. Every so often, and always the first time, the whole frame is drawn in
+// place from the top left corner. Otherwise only the cells that changed since the last frame we drew are sent.
+static void draw_frame(Renderer_T *r, const Frame_T *f) {
+
+    // Only emit differential code if it's turned on
+    #if DIFFERENTIAL_RENDERING == true
+    if (r->since_refresh > 0 && r->since_refresh < FULL_REFRESH_INTERVAL) {
+        render_frame_changes(&r->output, f, &r->shown);
+        r->since_refresh++;
+    } else {
+
+        // Wipe the screen the first time, so we're not drawing over top of whatever was there
+        output_string(&r->output, r->since_refresh == 0 ? CONSOLE_CLEAR CONSOLE_HOME : CONSOLE_HOME);
+        render_frame(&r->output, f);
+        r->since_refresh = 1;
+    }
+    copy_frame(&r->shown, f);
+    #else
+    render_frame(&r->output, f);
+    #endif
+
+    output_flush(&r->output);
+}
+
+// Body of the render thread. Every tick of the pacer it checks if a frame has been published, swaps the ready frame in
+// for drawing, and draws it without holding the lock. Ticking off of absolute deadlines means the terminal is written
+// to at most FPS times a second, and time spent drawing doesn't add onto the frame time. When the renderer is stopped,
+// it makes sure to draw whatever was published last before returning.
+static void *render_thread(void *arg) {
+    Renderer_T *r;
+    bool running;
+
+    r = arg;
+
+    init_pacer(&r->pacer, FPS);
+    do {
+        bool fresh;
+
+        // Take the latest frame for ourselves if there is one
+        pthread_mutex_lock(&r->lock);
+        running = r->running;
+        fresh = r->fresh;
+        if (fresh) {
+            int swap;
+
+            swap = r->drawing;
+            r->drawing = r->ready;
+            r->ready = swap;
+            r->fresh = false;
+        }
+        pthread_mutex_unlock(&r->lock);
+
+        // Draw without holding the lock, so the simulation can keep publishing
+        if (fresh) {
+            draw_frame(r, &r->frames[r->drawing]);
+        }
+
+        // Don't bother waiting out the frame if we're done
+        if (running) {
+            pacer_wait(&r->pacer);
+        }
+    } while (running);
+
+    return NULL;
+}
+
+// See renderer.h
+Renderer_T *new_renderer(int height, int width) {
+    Renderer_T *r;
+    int i;
+
+    r = safe_malloc(sizeof(Renderer_T));
+
+    // Set up our buffers
+    for (i = 0; i < 3; i++) {
+        init_frame(&r->frames[i], height, width);
+    }
+    init_frame(&r->shown, height, width);
+    init_output(&r->output, frame_output_size(&r->frames[0]) + sizeof(CONSOLE_CLEAR CONSOLE_HOME));
+    r->since_refresh = 0;
+    r->writing = 0;
+    r->ready = 1;
+    r->drawing = 2;
+    r->fresh = false;
+    r->running = true;
+
+    // Set up our synchronization and start drawing
+    pthread_mutex_init(&r->lock, NULL);
+    if (pthread_create(&r->thread, NULL, &render_thread, r) != 0) {
+        bail(INVALID_STATE, "FATAL ERROR! FAILED TO START THE RENDER THREAD!\n");
+    }
+
+    return r;
+}
+
+// Helper that hands the writing frame off as the new ready frame. If the last ready frame was never drawn, it's simply
+// dropped.
+static void publish_writing_frame(Renderer_T *r) {
+    int swap;
+
+    pthread_mutex_lock(&r->lock);
+    swap = r->ready;
+    r->ready = r->writing;
+    r->writing = swap;
+    r->fresh = true;
+    pthread_mutex_unlock(&r->lock);
+}
+
+// See renderer.h
+void renderer_publish(Renderer_T *r, const Dungeon_T *d) {
+
+    // The writing frame belongs to us, so it can be filled in without the lock
+    capture_frame(&r->frames[r->writing], d);
+    publish_writing_frame(r);
+}
+
+// See renderer.h
+void renderer_publish_frame(Renderer_T *r, const Frame_T *f) {
+    copy_frame(&r->frames[r->writing], f);
+    publish_writing_frame(r);
+}
+
+// See renderer.h
+void stop_renderer(Renderer_T *r) {
+    bool running;
+
+    // Tell the thread to finish up, and wait for it to draw the last frame
+    pthread_mutex_lock(&r->lock);
+    running = r->running;
+    r->running = false;
+    pthread_mutex_unlock(&r->lock);
+
+    if (running) {
+        pthread_join(r->thread, NULL);
+    }
+}
+
+// See renderer.h
+void cleanup_renderer(Renderer_T *r) {
+    int i;
+
+    stop_renderer(r);
+
+    // Cleanup
+    pthread_mutex_destroy(&r->lock);
+    for (i = 0; i < 3; i++) {
+        cleanup_frame(&r->frames[i]);
+    }
+    cleanup_frame(&r->shown);
+    cleanup_output(&r->output);
+    free(r);
+}
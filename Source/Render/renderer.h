@@ -0,0 +1,48 @@
+#ifndef ROGUE_RENDERER_H
+#define ROGUE_RENDERER_H
+
+#include <stdbool.h>
+#include <pthread.h>
+
+#include "frame.h"
+
+#include "Helpers/pacer.h"
+
+// See renderer.c for helper functions
+
+// A renderer draws frames on its own thread, so a slow terminal never stalls the game logic. Frames are triple
+// buffered: the simulation always owns the writing frame, the render thread always owns the drawing frame, and the
+// ready frame is the latest finished snapshot waiting to be drawn. Publishing and picking up a frame only swap indices
+// under the lock, so neither side ever waits on the other for longer than that. If the simulation publishes faster
+// than the terminal can keep up with, stale frames are simply overwritten and never drawn. The render thread ticks at
+// FPS off of its own pacer, whose stats can be read once the renderer is stopped. Frames are composed into an output
+// buffer allocated once for the worst case, and go out to the terminal in a single write. The renderer remembers the
+// frame the terminal is showing, so it only has to send the cells that changed since (see DIFFERENTIAL_RENDERING).
+typedef struct Renderer_S {
+    Frame_T frames[3];
+    Frame_T shown;
+    int writing, ready, drawing, since_refresh;
+    bool fresh, running;
+    Pacer_T pacer;
+    Output_T output;
+    pthread_t thread;
+    pthread_mutex_t lock;
+} Renderer_T;
+
+// Returns a new renderer for dungeons of the given size, with its render thread already running
+Renderer_T *new_renderer(int height, int width);
+
+// Snapshots the dungeon into the writing frame, and hands it off to the render thread. Never blocks on drawing.
+void renderer_publish(Renderer_T *r, const Dungeon_T *d);
+
+// Copies an already captured frame into the writing frame, and hands it off the same way. The frame must be the same
+// size the renderer was made for.
+void renderer_publish_frame(Renderer_T *r, const Frame_T *f);
+
+// Stops the render thread, making sure the last published frame has been drawn. Safe to call more than once.
+void stop_renderer(Renderer_T *r);
+
+// Stops the renderer if it's still running, and frees it.
+void cleanup_renderer(Renderer_T *r);
+
+#endif //ROGUE_RENDERER_H
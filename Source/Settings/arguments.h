@@ -32,10 +32,56 @@
 #define NUMMON_LONG "--nummon"
 #define NUMMON_SHORT "-n"
 
+// Dungeon size options. Use --height <rows> and --width <columns>
+#define HEIGHT_LONG "--height"
+#define HEIGHT_SHORT ""
+#define WIDTH_LONG "--width"
+#define WIDTH_SHORT ""
+
 // Print options
 #define PRINT_LONG "--print"
 #define PRINT_SHORT "-p"
 
+// Color options. Use --color <mode> or --color=<mode>
+#define COLOR_LONG "--color"
+#define COLOR_SHORT ""
+
+// Frame recording options. Use --record-frames <file>
+#define RECORD_FRAMES_LONG "--record-frames"
+#define RECORD_FRAMES_SHORT ""
+
+// Frame playback options. Use --play-frames <file>
+#define PLAY_FRAMES_LONG "--play-frames"
+#define PLAY_FRAMES_SHORT ""
+
+// Playback speed options. Use --play-speed <multiplier>
+#define PLAY_SPEED_LONG "--play-speed"
+#define PLAY_SPEED_SHORT ""
+
+// Batch generation options. Use --generate <count>
+#define GENERATE_LONG "--generate"
+#define GENERATE_SHORT ""
+
+// Batch output directory options. Use --out-dir <directory>
+#define OUT_DIR_LONG "--out-dir"
+#define OUT_DIR_SHORT ""
+
+// Batch thread options. Use --threads <count>
+#define THREADS_LONG "--threads"
+#define THREADS_SHORT ""
+
+// Generation stats options. Use --gen-stats <count>
+#define GEN_STATS_LONG "--gen-stats"
+#define GEN_STATS_SHORT ""
+
+// World options. Use --world <dir> to keep chunks somewhere other than the default
+#define WORLD_LONG "--world"
+#define WORLD_SHORT ""
+
+// World window options. Use --world-at <row>,<column>
+#define WORLD_AT_LONG "--world-at"
+#define WORLD_AT_SHORT ""
+
 // Help options
 #define HELP_LONG "--help"
 #define HELP_SHORT ""
@@ -14,8 +14,12 @@
 // Defines if characters can move diagonally
 #define CHARACTER_DIAGONAL_TRAVEL true
 
-// How many times the algorithm will try to place a monster... really only comes into play if the number of monsters is
-// insanely high.
-#define FAILED_MONSTER_PLACEMENT 2000
+// What the player cost maps are scaled by to build flee maps. Has to be negative; the further below -1 it is, the more
+// a fleeing monster will pass by the player to get somewhere further away instead of backing into a corner.
+#define FLEE_MULTIPLIER (-1.2)
+
+// How many cells on a side each bucket of the monster spatial index covers. Smaller buckets mean less wasted checks
+// on queries, but more buckets to walk over for big ones.
+#define SPATIAL_BLOCK_SIZE 8
 
 #endif //ROGUE_CHARACTER_SETTINGS_H
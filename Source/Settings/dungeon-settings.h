@@ -4,22 +4,38 @@
 // This file sets all defaults and compile time settings related to dungeon generation... some of these parameters
 // should not be changed and will cause errors if they are out of bounds. Use with caution.
 
-// Defines the dungeon dimensions... in theory it could accept any size... most parameters are tuned to work well
-// with these dimensions. I wouldn't change them.
+// Defines the default dungeon dimensions, which --height and --width override. Most parameters are tuned to work well
+// with these dimensions, and room counts are scaled off of them for other sizes. Saved dungeons of this size use the
+// original file format, so I wouldn't change them.
 #define DUNGEON_HEIGHT 21
 #define DUNGEON_WIDTH 80
 
+// Limits for --height and --width. The minimums are the smallest dungeon whose first partition can always be split
+// (two minimum partitions plus the border), since generation always splits it. The maximums keep coordinates in the
+// 16 bits saved files and recordings have for them, and memory in check... every cell costs about 50 bytes between the
+// map, the room ids, the free cells and the cost maps.
+#define MIN_DUNGEON_HEIGHT (2 * MIN_PARTITION_HEIGHT + 2)
+#define MIN_DUNGEON_WIDTH (2 * MIN_PARTITION_WIDTH + 2)
+#define MAX_DUNGEON_HEIGHT 4096
+#define MAX_DUNGEON_WIDTH 4096
+
 // If you want dungeons with more rooms covering them, increase the percentage. Must be between 0.0 and 1.0
-// Too high and you won't generate workable dungeons and the program will error out.
+// Too high and rooms can't cover enough of the map and the program will error out.
 #define PERCENTAGE_ROOM_COVERED .1
 
+// Places rooms by picking them straight out of the sizes and spots that fit in each partition, instead of guessing and
+// checking them. Rooms are sized up front to cover PERCENTAGE_ROOM_COVERED, so a dungeon always comes out on the first
+// pass. Set it to false to go back to guessing, which uses the limits below.
+#define CONSTRUCTIVE_ROOM_PLACEMENT true
+
 // How many times the code tries to place rooms in a partition, or generate an entire dungeon. Only really comes into
 // play if you set too high or strict of standards for the dungeon generation parameters
 #define FAILED_ROOM_PLACEMENT 2000
 #define FAILED_DUNGEON_GENERATION 2000
 
 // Defines the default for the minimum or maximum number of rooms... will be somewhere in this range
-// Too strict and you won't generate workable dungeons.
+// Too strict and you won't generate workable dungeons. These are for a DUNGEON_HEIGHT x DUNGEON_WIDTH dungeon, and get
+// scaled by area for any other size.
 #define MIN_NUM_ROOMS 3
 #define MAX_NUM_ROOMS 10
 
@@ -53,6 +69,24 @@
 #define MAX_ROCK_HARDNESS 254
 #define IMMUTABLE_ROCK_HARDNESS 255
 
+// Makes hardness smooth, with veins of hard and soft rock that corridors bend around, instead of every cell being
+// random on its own. It's value noise, with the biggest features HARDNESS_NOISE_SCALE cells across, and every octave
+// after adding detail half the size. Either way, the same seed always gives the same hardness.
+#define SMOOTH_HARDNESS false
+#define HARDNESS_NOISE_SCALE 16
+#define HARDNESS_NOISE_OCTAVES 3
+
+// Settings for --world. A world is WORLD_HEIGHT x WORLD_WIDTH cells, far more than would fit in memory as one dungeon,
+// and is split into WORLD_CHUNK_HEIGHT x WORLD_CHUNK_WIDTH chunks that are each generated like a small dungeon. The
+// game is played in a --height x --width window of it, and only the chunks under the window are ever loaded, keeping at
+// most WORLD_CACHE_BYTES of them around. Chunks have to be at least MIN_DUNGEON_HEIGHT x MIN_DUNGEON_WIDTH, and the
+// world has to be a whole number of them.
+#define WORLD_HEIGHT 65536
+#define WORLD_WIDTH 65536
+#define WORLD_CHUNK_HEIGHT 64
+#define WORLD_CHUNK_WIDTH 128
+#define WORLD_CACHE_BYTES (64 * 1024 * 1024)
+
 // Don't know why you would change these. Default hardness would be the only one to maybe tweak if you wanted corridors
 // to be straighter but... probably better not to mess with it.
 #define DEFAULT_CELL_TYPE ROCK
@@ -9,16 +9,38 @@
 #define DEFAULT_DUNGEON_NAME "dungeon"
 #define DEFAULT_PGM_NAME "dungeon.pgm"
 
-// Setting to define the maximum file size in bytes... currently set to be the theoretical maximum: a grid of 1x1 roms
-// each filled with a stair. A dungeon *literally* cannot be bigger than this unless it has rooms that completely
-// overlap, or stairs that overlap... in which case it's such a bad dungeon, it's not viable, and we can probably
-// safely reject it.
-#define MAX_DUNGEON_FILE_SIZE 11788
-#define MAX_PGM_FILE_SIZE 4096
+// Settings for --generate. Dungeons go in DEFAULT_GENERATE_DIRECTORY unless --out-dir says otherwise, and are named
+// <prefix>-<seed>, with the PGM copy getting the extension tacked on.
+#define DEFAULT_GENERATE_DIRECTORY "."
+#define GENERATE_FILE_PREFIX "dungeon"
+#define GENERATE_PGM_EXTENSION ".pgm"
+
+// Setting to define the maximum file size in bytes... currently set to be the theoretical maximum for the biggest
+// dungeon: every cell a 1x1 room filled with a stair, with 16 bit coordinates. A dungeon *literally* cannot be bigger
+// than this unless it has rooms that completely overlap, or stairs that overlap... in which case it's such a bad
+// dungeon, it's not viable, and we can probably safely reject it. PGMs are the map and a short header.
+#define MAX_DUNGEON_FILE_SIZE (64ULL + 13ULL * MAX_DUNGEON_HEIGHT * MAX_DUNGEON_WIDTH)
+#define MAX_PGM_FILE_SIZE (256ULL + (unsigned long long) MAX_DUNGEON_HEIGHT * MAX_DUNGEON_WIDTH)
 
 // Setting for the version of saved and loaded files. The header must match this, or we will bail and not read them.
+// FILE_VERSION is the original format, which is always DUNGEON_HEIGHT x DUNGEON_WIDTH with 8 bit coordinates.
+// SIZED_FILE_VERSION adds the height and width after the file size, and widens coordinates to 16 bits and counts to 32
+// bits. Dungeons are saved in the original format whenever they fit in it, so other programs can still read them.
 #define FILE_MARKER "RLG327-S2021"
 #define FILE_VERSION 0
+#define SIZED_FILE_VERSION 1
+
+// Setting for the version of frame recordings. Same deal as saved dungeons: the header must match to play one back.
+#define FRAME_FILE_MARKER "RLG327-FRAMES"
+#define FRAME_FILE_VERSION 0
+
+// Settings for --world. Chunks that were changed are saved in DEFAULT_WORLD_DIRECTORY under the save path unless
+// --world says otherwise, named <prefix>-<seed>-<row>-<column>, so worlds from different seeds can share a directory.
+// The header must match to load one back, or the chunk is generated again instead.
+#define DEFAULT_WORLD_DIRECTORY "world"
+#define WORLD_CHUNK_PREFIX "chunk"
+#define CHUNK_FILE_MARKER "RLG327-CHUNK"
+#define CHUNK_FILE_VERSION 1
 
 // PGM file settings
 #define PGM_MAGIC_NUMBER "P5"
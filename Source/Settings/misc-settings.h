@@ -3,9 +3,6 @@
 
 // This file sets all the misc Settings that don't belong under others
 
-// Default size for the stack data structure
-#define DEFAULT_STACK_SIZE 50
-
 // Current assignment due
 #define VERSION "assignment-1.04"
 
@@ -13,6 +10,9 @@
 // for the purposes of tunneling monsters.
 #define TUNNEL_NUM_HARDNESS_LEVELS 3
 
+// How many cells each bucket of the room Dijkstra map starts out with room for. They double when they fill up.
+#define ROOM_BUCKET_SIZE 1024
+
 // Controls how diagonal movement happens. With DIAGONAL_NEEDS_OPEN_WALL set to true,
 // regular monsters won't be able to go diagonally if one of the immediate directions (north, south, east, west) are not
 // open as well. This is to stop monsters from jumping between corridors or rooms where they touch at the corner.
@@ -24,4 +24,7 @@
 // Defines how many times the dungeon should be printed per second
 #define FPS 4
 
+// How much faster than real time recordings are played back, unless --play-speed says otherwise
+#define DEFAULT_PLAY_SPEED 1.0
+
 #endif //ROGUE_MISC_SETTINGS_H
@@ -55,26 +55,40 @@
 #define MONSTER_15_CHAR 'f'
 #define MONSTER_15_COLOR FOREGROUND_PINK
 
-// Settings to control how the dungeon is printed
+// Settings to control how the dungeon is printed. The plain chars are used instead when colors are turned off.
 #define ROCK_COLOR FOREGROUND_WHITE
 #define ROCK_BACKGROUND BACKGROUND_WHITE
 #define ROCK_CHAR ' '
+#define ROCK_PLAIN_CHAR ' '
 
 #define CORRIDOR_COLOR FOREGROUND_WHITE
 #define CORRIDOR_BACKGROUND BACKGROUND_GREY
 #define CORRIDOR_CHAR ' '
+#define CORRIDOR_PLAIN_CHAR '#'
 
 #define ROOM_COLOR FOREGROUND_WHITE
 #define ROOM_BACKGROUND BACKGROUND_BLACK
 #define ROOM_CHAR ' '
+#define ROOM_PLAIN_CHAR '.'
 
 #define STAIR_UP_COLOR ROOM_COLOR
 #define STAIR_UP_BACKGROUND ROOM_BACKGROUND
 #define STAIR_UP_CHAR '<'
+#define STAIR_UP_PLAIN_CHAR STAIR_UP_CHAR
 
 #define STAIR_DOWN_COLOR ROOM_COLOR
 #define STAIR_DOWN_BACKGROUND ROOM_BACKGROUND
 #define STAIR_DOWN_CHAR '>'
+#define STAIR_DOWN_PLAIN_CHAR STAIR_DOWN_CHAR
+
+// How colors are sent to the terminal unless --color says otherwise. See Color_Mode_T in output.h.
+#define DEFAULT_COLOR_MODE TRUECOLOR_MODE
+
+// Settings to control how the game is drawn while playing. With differential rendering on, only the cells that changed
+// since the last frame are redrawn in place, and the whole map is redrawn every FULL_REFRESH_INTERVAL frames in case
+// the terminal got scribbled on. With it off, every frame is printed in full, one after the other.
+#define DIFFERENTIAL_RENDERING true
+#define FULL_REFRESH_INTERVAL 40
 
 // Setting to control how cost maps are printed
 #define COST_MAP_BACKGROUND BACKGROUND_BLACK
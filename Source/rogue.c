@@ -1,6 +1,11 @@
 #include "Character/character.h"
 #include "Dungeon/dungeon.h"
+#include "Dungeon/Loaders/dungeon-batch.h"
+#include "Dungeon/Loaders/dungeon-stats.h"
+#include "Dungeon/world.h"
 #include "Helpers/program-init.h"
+#include "Render/recording.h"
+#include "Settings/dungeon-settings.h"
 
 // All this is is a driver for the underlying headers... this entire codebase is designed to carry forward through
 // the entire semester, so main() will always contain minimal code. Not going to bother commenting heavily on what its
@@ -8,12 +13,33 @@
 int main(int argc, const char *argv[]) {
     Program_T p;
     Dungeon_T *d;
+    World_T *w;
 
     init_program(argc, argv, &p);
 
-    d = p.pgm_load ? new_dungeon_from_pgm(p.load_path, p.stairs, p.num_monsters) :
-        p.load ? new_dungeon_from_disk(p.load_path, p.stairs, p.num_monsters) :
-        new_random_dungeon(p.num_monsters);
+    if (p.play_frames) {
+        play_recording(p.play_path, p.play_speed);
+        cleanup_program(&p);
+        return 0;
+    }
+
+    if (p.gen_stats) {
+        report_generation_stats(p.num_gen_stats, p.seed, p.height, p.width);
+        cleanup_program(&p);
+        return 0;
+    }
+
+    if (p.generate) {
+        generate_dungeon_batch(p.num_generate, p.seed, p.height, p.width, p.generate_dir, p.num_threads);
+        cleanup_program(&p);
+        return 0;
+    }
+
+    w = p.world ? new_world(p.world_dir, p.seed, WORLD_CACHE_BYTES) : NULL;
+    d = w != NULL ? new_dungeon_from_world(w, p.world_y, p.world_x, p.height, p.width, p.num_monsters, p.seed) :
+        p.pgm_load ? new_dungeon_from_pgm(p.load_path, p.stairs, p.height, p.width, p.num_monsters, p.seed) :
+        p.load ? new_dungeon_from_disk(p.load_path, p.stairs, p.height, p.width, p.num_monsters, p.seed) :
+        new_random_dungeon(p.height, p.width, p.num_monsters, p.seed);
 
     if (p.save) {
         save_dungeon_to_disk(d, p.save_dungeon_path);
@@ -27,9 +53,16 @@ int main(int argc, const char *argv[]) {
         print_dungeon(d);
         print_dungeon_cost_maps(d);
     } else {
-        play_dungeon(d);
+        play_dungeon(d, p.record_frames ? p.record_path : NULL);
+    }
+
+    if (w != NULL) {
+        save_dungeon_to_world(d, w, p.world_y, p.world_x);
+        flush_world(w);
+        print_world_stats(w);
+        cleanup_world(w);
     }
-    
+
     cleanup_dungeon(d);
     cleanup_program(&p);
 }